@@ -1,35 +1,56 @@
 #pragma once
+#include "gomoku/ai/PvTable.hpp"
+#include "gomoku/ai/SearchArena.hpp"
 #include "gomoku/ai/SearchStats.hpp"
+#include "gomoku/ai/ThreatSolver.hpp"
 #include "gomoku/ai/TranspositionTable.hpp"
+#include "gomoku/core/MoveList.hpp"
 #include "gomoku/core/Types.hpp"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
 namespace gomoku {
-class Board;
+template <int Size>
+class BasicBoard;
+using Board = BasicBoard<BOARD_SIZE>;
+
+// How extra search threads cooperate
+enum class ParallelMode : uint8_t {
+    LazySmp, // independent searches of the root sharing the TT
+    Ybwc // Young Brothers Wait: siblings of a searched eldest child are stolen by idle threads
+};
 
 struct SearchConfig {
     int timeBudgetMs = 450; // Budget temps (ms) pour la recherche
     int maxDepthHint = 11; // Profondeur max d'itération
     std::size_t ttBytes = (64ull << 20); // Taille allouée à la table de transposition
-    unsigned long long nodeCap = 0; // Limite de nœuds dure (0 = désactivée)
+    unsigned long long nodeCap = 0; // Limite de nœuds dure (0 = désactivée), tous threads confondus
+    int threads = 1; // Threads de recherche (parallèles au-delà de 1)
+    ParallelMode parallel = ParallelMode::LazySmp; // Stratégie des threads supplémentaires
+    bool threatSolver = true; // Recherche VCF/VCT à la racine et VCF aux nœuds intérieurs
 };
 
 class MinimaxSearch {
 public:
-    explicit MinimaxSearch(const SearchConfig& conf)
-        : cfg(conf)
-    {
-    }
+    explicit MinimaxSearch(const SearchConfig& conf);
+    ~MinimaxSearch(); // Defined in .cpp (Board is incomplete here)
 
     std::optional<Move> bestMove(Board& board, const RuleSet& rules, SearchStats* stats);
 
     // Configuration helpers used by MinimaxSearchEngine
     void setTimeBudgetMs(int ms) { cfg.timeBudgetMs = ms; }
     void setMaxDepthHint(int d) { cfg.maxDepthHint = d; }
+    // Lazy SMP: helpers search the same root on their own boards and share the TT
+    void setThreads(int n) { cfg.threads = n < 1 ? 1 : n; }
+    // YBWC: idle threads steal the younger siblings of nodes whose eldest child is searched
+    void setParallelMode(ParallelMode mode) { cfg.parallel = mode; }
 
     void setTranspositionTableSize(std::size_t bytes)
     {
@@ -37,7 +58,8 @@ public:
         tt.resizeBytes(bytes);
     }
 
-    void clearTranspositionTable() { tt.resizeBytes(cfg.ttBytes); }
+    // Also forgets the threat solvers' results
+    void clearTranspositionTable();
 
     // Lightweight public helpers for tooling/analysis
     int evaluatePublic(const Board& board, Player perspective) const { return evaluate(board, perspective); }
@@ -50,31 +72,152 @@ private:
         std::chrono::steady_clock::time_point deadline;
         SearchStats* stats { nullptr };
         unsigned long long nodeCap { 0 };
+        // Shared by all search threads: stop request and nodes flushed by the threads
+        std::atomic<bool>& stop;
+        std::atomic<unsigned long long>& sharedNodes;
+        std::atomic<int>& idleThreads; // YBWC helpers looking for work
+        std::atomic<int>& splits; // YBWC split points created
+        // YBWC: bumped whenever split work appears or a thread leaves a split; threads with
+        // nothing to do wait on it instead of spinning
+        std::atomic<uint32_t>& workSignal;
+    };
+
+    // Killer moves kept per ply
+    static constexpr int KILLERS = 2;
+    // YBWC: only nodes with at least this much depth left share their siblings
+    static constexpr int SPLIT_MIN_DEPTH = 2;
+    // Threat solver limits (attacking moves, solver nodes): at the root before the main
+    // search, then VCF only at interior nodes with at least VCF_MIN_DEPTH plies left where
+    // the side to move can start one (ThreatSolver::canStartVcf)
+    static constexpr int ROOT_VCF_ATTACKS = 12;
+    static constexpr int ROOT_VCT_ATTACKS = 6;
+    static constexpr long long ROOT_SOLVER_NODES = 2000;
+    static constexpr int NODE_VCF_ATTACKS = 6;
+    static constexpr long long NODE_SOLVER_NODES = 200;
+    static constexpr int VCF_MIN_DEPTH = 3;
+
+    struct Worker;
+
+    // YBWC split point: a node whose eldest child is searched and whose remaining
+    // moves are taken one at a time (next) by the owner and the threads that stole it.
+    // Helpers rebuild the node on their own board by replaying path from the root.
+    struct SplitPoint {
+        std::mutex lock; // guards best, bestMove and the owner's PV row
+        const MoveList* moves { nullptr }; // owner's list, alive until every helper left
+        std::atomic<int> next { 0 };
+        std::atomic<int> alpha { 0 };
+        std::atomic<int> active { 0 }; // helpers currently working here
+        std::atomic<bool> cutoff { false };
+        int beta { 0 };
+        int depth { 0 };
+        int ply { 0 };
+        int best { 0 };
+        PackedMove bestMove { PackedMove::none() };
+        std::array<PackedMove, PvTable::MAX_PLY> path {};
+        Worker* owner { nullptr };
+        const SplitPoint* parent { nullptr }; // split the owner was helping (cutoffs propagate down)
+    };
+
+    // State owned by one search thread: the main one (index 0) or a Lazy SMP helper.
+    // Allocated once and reused across searches, so searching does not allocate.
+    struct Worker {
+        int id { 0 };
+        Board* board { nullptr }; // main: the caller's board; helpers: ownBoard, copied per search
+        std::unique_ptr<Board> ownBoard;
+        PvTable pvTable;
+        SearchArena arena;
+        // Node counter, abort flag and the previous iteration's PV (searched first)
+        unsigned long long nodes { 0 };
+        bool aborted { false };
+        bool followPv { false };
+        std::array<PackedMove, PvTable::MAX_PLY> prevPv {};
+        int prevPvLength { 0 };
+        // Killer moves: the last quiet moves that caused a beta cutoff at each ply (tried early)
+        std::array<std::array<PackedMove, KILLERS>, PvTable::MAX_PLY> killers {};
+        // History: beta cutoffs per color and cell, weighted by depth (orders quiet moves)
+        std::array<std::array<int, BOARD_SIZE * BOARD_SIZE>, 2> history {};
+        int ttProbes { 0 }, ttHits { 0 }, ttCollisions { 0 };
+        // VCF/VCT solver with its own cache, and the moves it played during this search
+        ThreatSolver solver;
+        long long threatNodes { 0 };
+        // YBWC: moves from the root to the current node, the innermost split being
+        // worked on, one split point per ply and the stack of splits open to thieves
+        std::array<PackedMove, PvTable::MAX_PLY> path {};
+        const SplitPoint* split { nullptr };
+        std::array<SplitPoint, PvTable::MAX_PLY> splits;
+        std::mutex dequeLock;
+        std::array<SplitPoint*, PvTable::MAX_PLY> deque {};
+        int dequeSize { 0 };
+
+        void resetForSearch();
+        void storeKiller(int ply, PackedMove m)
+        {
+            if (killers[ply][0] == m)
+                return;
+            killers[ply][1] = killers[ply][0];
+            killers[ply][0] = m;
+        }
     };
     // --- Constants for search scoring ---
     static constexpr int INF = 1'000'000; // Generic infinity bound for alpha-beta
     static constexpr int MATE_SCORE = 900'000; // Base score for mate-like terminal outcomes
 
     // --- Core search primitives (signatures only) ---
+    // Templated on the rule variant: bestMove picks it once (withRuleVariant) and the
+    // whole search then plays moves through the specialized rule engine.
+
+    // Iterative deepening driver behind bestMove
+    template <RuleVariant V>
+    std::optional<Move> search(Board& board, const RuleSet& rules, SearchStats* stats);
 
-    // Negamax with alpha-beta pruning and PVS. Returns best score and fills PV.
+    // Lazy SMP helper: iterative deepening on w's board until the main thread stops it
+    template <RuleVariant V>
+    void helperSearch(Worker& w, const MoveList& rootCandidates, const SearchContext& ctx);
+    // YBWC helper: steals split points from the other threads until the search stops
+    template <RuleVariant V>
+    void ybwcHelper(Worker& w, const SearchContext& ctx);
+    // Shares moves[from..] of the node at ply once its eldest child is searched; returns
+    // with best/bestMove/alpha merged from every thread that took part
+    template <RuleVariant V>
+    void splitNode(Worker& w, const MoveList& moves, int from, int depth, int& alpha, int beta, int ply,
+        int& best, PackedMove& bestMove, const SearchContext& ctx);
+    // Takes moves from sp until none remain or a cutoff; w.board must be at the split node
+    template <RuleVariant V>
+    void searchSplit(Worker& w, SplitPoint& sp, const SearchContext& ctx);
+    // Stolen split: plays sp's path from ply 'from' (where w.board stands), searches sp,
+    // goes back to ply 'from' and leaves sp
+    template <RuleVariant V>
+    void joinSplit(Worker& w, SplitPoint& sp, int from, const SearchContext& ctx);
+    // Another thread's split point with moves left (marked active), or nullptr.
+    // With 'under', only the splits nested in it.
+    SplitPoint* stealSplit(Worker& thief, const SplitPoint* under = nullptr);
+    // Wakes the threads waiting on ctx.workSignal
+    static void signalWork(const SearchContext& ctx);
+    bool canSplit(const Worker& w, int depth, int movesLeft, const SearchContext& ctx) const;
+    // True when sp or a split it is nested in was cut off
+    static bool cutOff(const SplitPoint* sp);
+
+    // Negamax with alpha-beta pruning and PVS (fail-soft). Returns best score and fills PV.
+    // - w: the searching thread's state (board, PV table, arena, killers, history, counters)
     // - depth: remaining plies to search (>= 0)
     // - alpha/beta: current search window
-    // - toMove: side to move at this node
     // - ply: distance from root (for mate distance correction)
-    // - stats: optional collector for node/qnode counters
-    // - pvOut: principal variation to be populated with best line
-    // - deadline: stop time for time management
-    int negamax(Board& board,
+    // - the best line from this node is written to row 'ply' of w.pvTable
+    // - time/node limits come from ctx; once hit, w.aborted is set and scores are meaningless
+    template <RuleVariant V>
+    int negamax(Worker& w,
         int depth,
         int alpha,
         int beta,
         int ply,
-        std::vector<Move>& pvOut,
         const SearchContext& ctx);
 
+    // Root threat search: first move of a forced VCF (then VCT) win of the side to move, if any
+    std::optional<Move> rootThreatWin(Worker& w, const RuleSet& rules, int& plies);
+
     // Quiescence search to stabilize evaluations in tactical positions.
     // Searches only tactical moves (captures/menaces fortes) until a quiet position.
+    template <RuleVariant V>
     int qsearch(Board& board,
         int alpha,
         int beta,
@@ -86,22 +229,32 @@ private:
 
     // Move ordering at a node: combines TT move, tactical generator, killers/history, etc.
     // For now the implementation will reuse CandidateGenerator as a base and sort.
-    std::vector<Move> orderMoves(const Board& board,
+    // Fills a fixed-capacity list (no allocation per node).
+    // ttMove (when legal here) comes first. V must be rules.variant().
+    template <RuleVariant V>
+    void orderMoves(const Board& board,
         const RuleSet& rules,
         Player toMove,
-        const std::optional<Move>& ttMove) const;
+        PackedMove ttMove,
+        MoveList& out) const;
 
     // Time management: returns true when we should abort the current search (soft stop).
-    bool cutoffByTime(const SearchContext& ctx) const;
+    // pendingNodes: nodes of the calling thread not yet flushed to ctx.sharedNodes.
+    bool cutoffByTime(const SearchContext& ctx, unsigned long long pendingNodes = 0) const;
+    // Per-node bookkeeping: counts the node and returns true once the search must stop
+    bool shouldAbort(Worker& w, const SearchContext& ctx) const;
 
     // Terminal detection with score. Returns true if the position is terminal and sets outScore.
     bool isTerminal(const Board& board, int ply, int& outScore) const;
 
-    // Transposition table helpers.
-    // Attempt to read an entry and, if applicable, return a bound for cutoff.
-    bool ttProbe(const Board& board, int depth, int alpha, int beta, int& outScore, std::optional<Move>& ttMove, TranspositionTable::Flag& outFlag) const;
+    // Transposition table helpers. Mate scores are stored relative to the node (ply).
+    // Attempt to read an entry: fills ttMove on any hit and returns true when its bound
+    // decides the node at this depth and window (outScore is then the score to return).
+    bool ttProbe(Worker& w, int depth, int alpha, int beta, int ply, int& outScore, PackedMove& ttMove);
     // Store a result into the TT.
-    void ttStore(const Board& board, int depth, int score, TranspositionTable::Flag flag, const std::optional<Move>& best);
+    void ttStore(Worker& w, int depth, int ply, int score, TranspositionTable::Flag flag, PackedMove best);
+    static int scoreToTT(int score, int ply);
+    static int scoreFromTT(int score, int ply);
 
     // Lightweight accounting for stats (node/qnode incrementers, killer/history updates, etc.).
     inline void onNodeVisited(SearchStats* stats) const
@@ -117,25 +270,31 @@ private:
 
     // --- Helpers extracted from bestMove for readability ---
     // Tries the immediate win shortcut if plausible; returns the winning move if found.
+    template <RuleVariant V>
     std::optional<Move> tryImmediateWinShortcut(Board& board,
         const RuleSet& rules,
         Player toPlay,
-        const std::vector<Move>& candidates) const;
+        const MoveList& candidates) const;
 
     // Runs one iterative-deepening step at a given depth; fills best, bestScore, pv and updates nodes.
-    bool runDepth(int depth,
-        Board& board,
+    template <RuleVariant V>
+    bool runDepth(Worker& w,
+        int depth,
         const RuleSet& rules,
         Player toPlay,
-        const std::vector<Move>& rootCandidates,
+        const MoveList& rootCandidates,
         std::optional<Move>& best,
         int& bestScore,
         std::vector<Move>& pv,
         long long& nodes,
         const SearchContext& ctx);
 
+    // Creates or drops helpers so that there are cfg.threads workers
+    void ensureWorkers();
+
     SearchConfig cfg {};
-    TranspositionTable tt;
+    TranspositionTable tt; // shared by all search threads
+    std::vector<std::unique_ptr<Worker>> workers; // [0] = main thread
 };
 
 } // namespace gomoku
@@ -2,6 +2,7 @@
 #include "gomoku/ai/MinimaxSearch.hpp"
 #include "gomoku/core/Types.hpp"
 #include "gomoku/interfaces/ISearchEngine.hpp"
+#include <memory>
 
 namespace gomoku::ai {
 
@@ -15,12 +16,18 @@ class MinimaxSearchEngine : public ISearchEngine {
 public:
     MinimaxSearchEngine();
     explicit MinimaxSearchEngine(const SearchConfig& config);
-    ~MinimaxSearchEngine() override = default;
+    ~MinimaxSearchEngine() override; // Defined in .cpp (Board is incomplete here)
 
     // Configuration methods
     void setTimeLimit(int milliseconds) override;
     void setDepthLimit(int maxDepth) override;
     void setTranspositionTableSize(size_t bytes) override;
+    void setThreadCount(int threads) override;
+
+    // Board synchronization
+    void onNewGame() override;
+    void onMovePlayed(const Move& move, const RuleSet& rules) override;
+    void onUndo() override;
 
     // MinimaxSearch operations
     std::optional<Move> findBestMove(
@@ -47,8 +54,14 @@ private:
     SearchConfig config_;
     SearchStats lastStats_;
 
-    // Helper to convert IBoardView to concrete Board for MinimaxSearch class
-    gomoku::Board boardFromView(const IBoardView& view) const;
+    // Engine-owned board, replayed from the move notifications
+    std::unique_ptr<gomoku::Board> board_;
+    bool synced_ { true }; // false after a notification the board rejected
+
+    // Board to search for a view: board_ when it holds the same position (no copy),
+    // the view itself when it is a Board, nullptr otherwise.
+    const gomoku::Board* boardFor(const IBoardView& view) const;
+    bool holds(const IBoardView& view) const;
 };
 
 } // namespace gomoku::ai
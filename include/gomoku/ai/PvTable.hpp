@@ -0,0 +1,59 @@
+#pragma once
+#include "gomoku/core/MoveList.hpp"
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <vector>
+
+namespace gomoku {
+
+// Triangular principal-variation table, preallocated once per search.
+//
+// Row 'ply' holds the best line found from that ply and has room for
+// MAX_PLY - ply moves, so the whole table is MAX_PLY * (MAX_PLY + 1) / 2
+// packed moves. A node clears its row on entry and, on a new best move,
+// writes the move followed by the child's row (ply + 1). Nothing allocates.
+class PvTable {
+public:
+    static constexpr int MAX_PLY = 64;
+
+    void clear(int ply) { length[ply] = 0; }
+
+    // Best line at 'ply' becomes m followed by the line of ply + 1
+    void update(int ply, PackedMove m) { update(ply, m, *this); }
+
+    // Same, the line of ply + 1 coming from another table (the thread that searched m)
+    void update(int ply, PackedMove m, const PvTable& from)
+    {
+        PackedMove* row = moves.data() + rowStart(ply);
+        row[0] = m;
+        int n = 1;
+        if (ply + 1 < MAX_PLY) {
+            const PackedMove* child = from.moves.data() + rowStart(ply + 1);
+            for (int i = 0; i < from.length[ply + 1]; ++i)
+                row[n++] = child[i];
+        }
+        length[ply] = n;
+    }
+
+    int size(int ply) const { return length[ply]; }
+    PackedMove at(int ply, int i) const { return moves[rowStart(ply) + i]; }
+
+    // Line of 'ply' as full moves (sides alternate from 'first'); reuses the capacity of out
+    void copyLine(int ply, Player first, std::vector<Move>& out) const
+    {
+        out.clear();
+        Player side = first;
+        for (int i = 0; i < length[ply]; ++i) {
+            out.push_back(at(ply, i).toMove(side));
+            side = opponent(side);
+        }
+    }
+
+private:
+    static constexpr int rowStart(int ply) { return ply * MAX_PLY - ply * (ply - 1) / 2; }
+
+    std::array<PackedMove, MAX_PLY * (MAX_PLY + 1) / 2> moves;
+    std::array<int, MAX_PLY> length {};
+};
+
+} // namespace gomoku
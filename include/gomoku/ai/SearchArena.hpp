@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace gomoku {
+
+// Bump allocator for the scratch buffers of one search (move lists per ply, ...).
+//
+// The buffer is allocated once; allocate() only moves an offset, and memory is
+// given back in LIFO order through mark()/release() (or Scope) and all at once
+// by reset() at the start of each iteration. Only trivially destructible types
+// are accepted since nothing is destroyed. A request that does not fit returns
+// nullptr: the caller decides how to degrade (the arena never grows mid-search).
+// One arena per searching thread; it is not thread-safe.
+class SearchArena {
+public:
+    static constexpr std::size_t DEFAULT_BYTES = 1u << 20;
+
+    explicit SearchArena(std::size_t bytes = DEFAULT_BYTES)
+        : buffer(new std::byte[bytes])
+        , capacity(bytes)
+    {
+    }
+
+    template <class T>
+    T* allocate(std::size_t n = 1)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "buffer alignment");
+        const std::size_t start = (offset + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (start + n * sizeof(T) > capacity)
+            return nullptr;
+        offset = start + n * sizeof(T);
+        if (offset > peak)
+            peak = offset;
+        T* p = reinterpret_cast<T*>(buffer.get() + start);
+        for (std::size_t i = 0; i < n; ++i)
+            ::new (p + i) T;
+        return p;
+    }
+
+    std::size_t mark() const { return offset; }
+    void release(std::size_t m) { offset = m; }
+    void reset() { offset = 0; }
+
+    std::size_t used() const { return offset; }
+    std::size_t highWater() const { return peak; }
+    std::size_t size() const { return capacity; }
+
+    // Releases everything allocated during its lifetime (one per search node)
+    class Scope {
+    public:
+        explicit Scope(SearchArena& a)
+            : arena(a)
+            , saved(a.mark())
+        {
+        }
+        ~Scope() { arena.release(saved); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        SearchArena& arena;
+        std::size_t saved;
+    };
+
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t capacity;
+    std::size_t offset { 0 };
+    std::size_t peak { 0 };
+};
+
+} // namespace gomoku
@@ -10,8 +10,13 @@ struct SearchStats {
     long long qnodes = 0;
     int depthReached = 0;
     int timeMs = 0;
-    int ttHits = 0;
+    int ttHits = 0; // TT probes that found the position
+    int ttProbes = 0;
+    int ttCollisions = 0; // stores that evicted another position of the same search
     std::vector<Move> principalVariation;
+    std::vector<long long> threadNodes; // nodes per search thread ([0] = main); nodes is their sum
+    int splits = 0; // YBWC split points offered to idle threads
+    long long threatNodes = 0; // moves played by the VCF/VCT solver (not counted in nodes)
 };
 
 } // namespace gomoku
@@ -0,0 +1,80 @@
+#pragma once
+#include "gomoku/core/MoveList.hpp"
+#include "gomoku/core/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace gomoku {
+template <int Size>
+class BasicBoard;
+using Board = BasicBoard<BOARD_SIZE>;
+
+// Threat-space solver: proves forced wins of the side to move made of continuous
+// fours (VCF) or of fours and threes (VCT).
+//
+// Only threat moves are generated for the attacker and only the replies that can
+// matter for the defender: the cells that stop the threat, every capture, the moves
+// that set up a capture of the threatening stones and the defender's own fives. A
+// VCT attempt is dropped when the defender can answer a three with a four. Wins are
+// checked by playing them on the board, so the rules decide (breakable fives,
+// capture wins, forbidden double-threes). Results are cached by Zobrist key in a
+// fixed-size table; nothing is allocated while solving. One solver per thread.
+class ThreatSolver {
+public:
+    enum class Mode : uint8_t { Vcf,
+        Vct };
+
+    struct Result {
+        std::optional<Move> move; // first attacking move of the forced win, if one was found
+        int plies = 0; // plies until the win (attacker moves included), 0 if none
+        long long nodes = 0; // moves played by the solver
+    };
+
+    static constexpr std::size_t DEFAULT_CACHE_ENTRIES = std::size_t { 1 } << 16;
+
+    explicit ThreatSolver(std::size_t cacheEntries = DEFAULT_CACHE_ENTRIES);
+
+    // Looks for a forced win of board.toPlay() in at most maxAttacks attacking moves,
+    // giving up after nodeBudget moves played. The board is restored before returning.
+    Result solve(Board& board, const RuleSet& rules, Mode mode, int maxAttacks, long long nodeBudget);
+
+    // Cheap necessary condition for a VCF win of board.toPlay(): one more stone makes a four
+    // or a five somewhere, or a capture can reach the capture-win count
+    static bool canStartVcf(const Board& board, const RuleSet& rules);
+
+    void clearCache();
+
+private:
+    struct CacheEntry {
+        uint64_t key = 0; // Zobrist key ^ mode salt
+        PackedMove move = PackedMove::none();
+        uint8_t depth = 0; // attacks searched without success
+        uint8_t win = 0; // attacking moves to the win (0: not proven)
+    };
+
+    // Attacker to move: number of attacking moves to a forced win (0 if none within depth)
+    template <RuleVariant V>
+    int attack(Board& board, const RuleSet& rules, int depth, PackedMove& move);
+    // Defender to move after the threat at 'threat': the longest of the attacker's wins
+    // over every relevant reply (0 if one reply holds)
+    template <RuleVariant V>
+    int defend(Board& board, const RuleSet& rules, int depth, Pos threat);
+    bool outOfBudget()
+    {
+        if (nodes < budget)
+            return false;
+        exhausted = true;
+        return true;
+    }
+
+    std::unique_ptr<CacheEntry[]> cache;
+    std::size_t mask = 0;
+    Mode mode = Mode::Vcf;
+    long long nodes = 0;
+    long long budget = 0;
+    bool exhausted = false; // budget ran out: failures are not cached
+};
+
+} // namespace gomoku
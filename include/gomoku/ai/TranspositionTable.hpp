@@ -1,65 +1,135 @@
 #pragma once
+#include "gomoku/core/MoveList.hpp"
 #include "gomoku/core/Types.hpp"
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <optional>
-#include <vector>
+#include <cstdlib>
+#include <memory>
 
 namespace gomoku {
 
+// Bucketed transposition table.
+//
+// Entries are 16 bytes and grouped by four in 64-byte buckets (one cache line):
+// a key maps to one bucket, the first three slots keep the deepest results
+// (older generations are evicted first) and the last one always takes the newest
+// result that found no better place. newSearch() starts a generation so results
+// of earlier moves age out without clearing the table. The storage is aligned for
+// transparent huge pages when large enough.
+//
+// Search threads share one table without locks: a slot holds two 64-bit words,
+// the packed data and key ^ data, each read and written atomically (relaxed). A
+// slot torn by concurrent writers no longer verifies and reads as a miss.
 class TranspositionTable {
 public:
     enum class Flag : uint8_t { Exact,
         Lower,
         Upper };
+
+    // Decoded content of a slot
     struct Entry {
-        uint64_t key = 0;
+        uint64_t key = 0; // full Zobrist key
+        int32_t score = 0;
+        PackedMove best = PackedMove::none(); // stored best move (none if unknown)
+        int8_t depth = 0;
+        uint8_t meta = 0; // generation << 3 | USED | flag
+    };
+
+    // 16 bytes in memory: data = score | best << 32 | depth << 48 | meta << 56
+    struct Slot {
+        std::atomic<uint64_t> check; // key ^ data
+        std::atomic<uint64_t> data;
+    };
+    static_assert(sizeof(Slot) == 16, "TT entries must stay 16 bytes");
+
+    static constexpr int BUCKET_SLOTS = 4;
+    static constexpr int ALWAYS_SLOT = BUCKET_SLOTS - 1;
+    struct alignas(64) Bucket {
+        std::array<Slot, BUCKET_SLOTS> slots {};
+    };
+    static_assert(sizeof(Bucket) == 64, "a bucket fills one cache line");
+
+    // What a probe returns for the position
+    struct Hit {
         int score = 0;
-        int depth = -1;
+        int depth = 0;
         Flag flag = Flag::Exact;
-        Move best { Pos { 255, 255 }, Player::Black }; // stored best move; (255,255) = invalid sentinel
+        PackedMove best = PackedMove::none();
     };
 
     TranspositionTable() = default;
 
-    void resizeBytes(std::size_t bytes)
+    // Reallocates to the largest power-of-two bucket count fitting in bytes (0: 16 MiB); contents are lost
+    void resizeBytes(std::size_t bytes);
+    // Empties every bucket, keeping the allocation
+    void clear();
+    // Starts a new search: entries of previous searches become replaceable first
+    void newSearch() { generation = static_cast<uint8_t>((generation + 1) & GEN_MASK); }
+
+    bool probe(uint64_t key, Hit& out) const
     {
-        if (!bytes)
-            bytes = (16ull << 20);
-        std::size_t n = bytes / sizeof(Entry);
-        if (n < 1024)
-            n = 1024;
-        std::size_t pow2 = 1;
-        while (pow2 < n)
-            pow2 <<= 1;
-        table.assign(pow2, Entry {});
-        mask = pow2 - 1;
+        if (!buckets)
+            return false;
+        for (const Slot& s : bucketOf(key).slots) {
+            const Entry e = load(s);
+            if (e.key == key && (e.meta & USED)) {
+                out = { e.score, e.depth, static_cast<Flag>(e.meta & FLAG_MASK), e.best };
+                return true;
+            }
+        }
+        return false;
     }
 
-    Entry* probe(uint64_t key) const
+    // Returns true when the store evicted another position of the current generation
+    bool store(uint64_t key, int depth, int score, Flag flag, PackedMove best);
+
+    // Brings the bucket of key into cache ahead of the probe
+    void prefetch(uint64_t key) const
     {
-        if (table.empty())
-            return nullptr;
-        return const_cast<Entry*>(&table[key & mask]);
+#if defined(__GNUC__) || defined(__clang__)
+        if (buckets)
+            __builtin_prefetch(&bucketOf(key));
+#else
+        (void)key;
+#endif
     }
 
-    void store(uint64_t key, int depth, int score, Flag flag, const std::optional<Move>& best)
+    std::size_t sizeBytes() const { return buckets ? (mask + 1) * sizeof(Bucket) : 0; }
+
+private:
+    static constexpr uint8_t FLAG_MASK = 0x3;
+    static constexpr uint8_t USED = 0x4;
+    static constexpr int GEN_SHIFT = 3;
+    static constexpr uint8_t GEN_MASK = 0x1F;
+
+    const Bucket& bucketOf(uint64_t key) const { return buckets[key & mask]; }
+    Bucket& bucketOf(uint64_t key) { return buckets[key & mask]; }
+    static Entry load(const Slot& s)
     {
-        if (table.empty())
-            return;
-        auto& e = table[key & mask];
-        if (e.key != key || depth >= e.depth) {
-            e.key = key;
-            e.depth = depth;
-            e.score = score;
-            e.flag = flag;
-            e.best = best.value_or(Move { Pos { 255, 255 }, Player::Black });
-        }
+        const uint64_t data = s.data.load(std::memory_order_relaxed);
+        const uint64_t check = s.check.load(std::memory_order_relaxed);
+        return { check ^ data, static_cast<int32_t>(static_cast<uint32_t>(data)), PackedMove::fromIndex(static_cast<uint16_t>(data >> 32)),
+            static_cast<int8_t>(static_cast<uint8_t>(data >> 48)), static_cast<uint8_t>(data >> 56) };
+    }
+    static void save(Slot& s, const Entry& e)
+    {
+        const uint64_t data = static_cast<uint32_t>(e.score) | uint64_t { e.best.raw() } << 32
+            | uint64_t { static_cast<uint8_t>(e.depth) } << 48 | uint64_t { e.meta } << 56;
+        s.data.store(data, std::memory_order_relaxed);
+        s.check.store(e.key ^ data, std::memory_order_relaxed);
     }
 
-private:
-    std::vector<Entry> table;
+    // Generations elapsed since e was written (0 = current search)
+    int age(const Entry& e) const { return (generation - (e.meta >> GEN_SHIFT)) & GEN_MASK; }
+
+    struct FreeDeleter {
+        void operator()(Bucket* p) const { std::free(p); }
+    };
+    std::unique_ptr<Bucket[], FreeDeleter> buckets;
     std::size_t mask = 0;
+    uint8_t generation = 0;
 };
 
 } // namespace gomoku
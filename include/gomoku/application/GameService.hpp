@@ -8,7 +8,9 @@
 
 // Forward declarations
 namespace gomoku {
-class Board;
+template <int Size>
+class BasicBoard;
+using Board = BasicBoard<BOARD_SIZE>;
 }
 
 namespace gomoku::application {
@@ -15,6 +15,7 @@ class MoveValidator {
 public:
     struct Result {
         bool ok { false };
+        PlayErrorCode code { PlayErrorCode::None };
         std::string reason; // vide si ok
     };
 
@@ -0,0 +1,187 @@
+#pragma once
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace gomoku {
+
+namespace detail {
+    inline constexpr int LINE_PAD = 5;
+    // Rows + columns + diagonals + anti-diagonals of a Size x Size board
+    constexpr int lineCount(int size) { return 2 * size + 2 * (2 * size - 1); }
+
+    // Location of a cell inside the line word of a given direction
+    struct LineSlot {
+        uint8_t line { 0 }; // line id (0..LINE_COUNT-1)
+        uint8_t bit { 0 }; // bit position inside the line word (>= LINE_PAD)
+    };
+
+    template <int S>
+    struct LineTables {
+        std::array<std::array<LineSlot, S * S>, 4> slots {};
+        std::array<uint32_t, lineCount(S)> walls {};
+    };
+
+    // Lines: rows (0..S-1), columns (S..2S-1), diagonals x-y, anti-diagonals x+y.
+    // Bits grow with x (or with y for columns).
+    template <int S>
+    constexpr LineTables<S> makeLineTables()
+    {
+        LineTables<S> t {};
+        for (int y = 0; y < S; ++y) {
+            for (int x = 0; x < S; ++x) {
+                const int idx = y * S + x;
+                const int diag = x - y + S - 1; // 0..2S-2
+                const int anti = x + y; // 0..2S-2
+                const int antiStart = anti > S - 1 ? anti - (S - 1) : 0;
+                const int line[4] = { y, S + x, 2 * S + diag, 2 * S + (2 * S - 1) + anti };
+                const int pos[4] = { x, y, x < y ? x : y, x - antiStart };
+                for (int d = 0; d < 4; ++d)
+                    t.slots[d][idx] = LineSlot { static_cast<uint8_t>(line[d]), static_cast<uint8_t>(LINE_PAD + pos[d]) };
+            }
+        }
+        auto setWall = [&](int line, int len) { t.walls[line] = ~(((1u << len) - 1u) << LINE_PAD); };
+        for (int i = 0; i < S; ++i) {
+            setWall(i, S);
+            setWall(S + i, S);
+        }
+        for (int k = 0; k < 2 * S - 1; ++k) {
+            const int len = S - (k > S - 1 ? k - (S - 1) : (S - 1) - k);
+            setWall(2 * S + k, len);
+            setWall(2 * S + (2 * S - 1) + k, len);
+        }
+        return t;
+    }
+
+    template <int S>
+    inline constexpr LineTables<S> LINE_TABLES = makeLineTables<S>();
+} // namespace detail
+
+// Per-color rotated bitboards.
+//
+// Every row, column, diagonal and anti-diagonal of the board is stored as one
+// 32-bit word per color, so that alignment and capture checks become a handful
+// of shifts and masks instead of cell-by-cell walks. Tables are generated at
+// compile time for each board size. Each line word keeps PAD
+// guard bits on both sides of the playable cells: a window of +-PAD cells around
+// any stone can therefore be extracted without bounds checks (guard bits are
+// never set; callers wanting "wall" semantics OR in wall(line)).
+template <int Size>
+class BasicBitboard {
+public:
+    static constexpr int SIZE = Size;
+    static constexpr int PAD = detail::LINE_PAD;
+    static constexpr int DIRS = 4; // Row (1,0), Col (0,1), Diag (1,1), Anti (1,-1)
+    static constexpr int CELLS = Size * Size;
+    static constexpr int LINES = detail::lineCount(Size);
+
+    // Same direction order as the DX/DY tables of the rule engine
+    static constexpr int DX[DIRS] = { 1, 0, 1, 1 };
+    static constexpr int DY[DIRS] = { 0, 1, 1, -1 };
+    // Linear index delta for one step along each direction
+    static constexpr int STEP[DIRS] = { 1, Size, Size + 1, 1 - Size };
+
+    using Slot = detail::LineSlot;
+
+    static constexpr Slot slot(int dir, int idx) { return detail::LINE_TABLES<Size>.slots[dir][idx]; }
+    // Guard bits of a line (everything outside its playable cells)
+    static constexpr uint32_t wall(int line) { return detail::LINE_TABLES<Size>.walls[line]; }
+    // Guard bits of every line (indexed by line id)
+    static constexpr const std::array<uint32_t, LINES>& walls() { return detail::LINE_TABLES<Size>.walls; }
+
+    void clear()
+    {
+        words = {};
+        fiveLines = {};
+    }
+
+    void set(Cell c, int idx)
+    {
+        const int ci = colorIndex(c);
+        auto& w = words[ci];
+        for (int d = 0; d < DIRS; ++d) {
+            const Slot s = detail::LINE_TABLES<Size>.slots[d][idx];
+            const bool had = fiveStarts(w[s.line]) != 0;
+            w[s.line] |= 1u << s.bit;
+            fiveLines[ci] += (fiveStarts(w[s.line]) != 0) - had;
+        }
+    }
+
+    void reset(Cell c, int idx)
+    {
+        const int ci = colorIndex(c);
+        auto& w = words[ci];
+        for (int d = 0; d < DIRS; ++d) {
+            const Slot s = detail::LINE_TABLES<Size>.slots[d][idx];
+            const bool had = fiveStarts(w[s.line]) != 0;
+            w[s.line] &= ~(1u << s.bit);
+            fiveLines[ci] += (fiveStarts(w[s.line]) != 0) - had;
+        }
+    }
+
+    bool test(Cell c, int idx) const
+    {
+        const Slot s = detail::LINE_TABLES<Size>.slots[0][idx];
+        return (words[colorIndex(c)][s.line] >> s.bit) & 1u;
+    }
+
+    Cell at(int idx) const
+    {
+        if (test(Cell::Black, idx))
+            return Cell::Black;
+        if (test(Cell::White, idx))
+            return Cell::White;
+        return Cell::Empty;
+    }
+
+    // Word of the line crossing idx in direction dir, for color c
+    uint32_t line(Cell c, int dir, int idx) const { return words[colorIndex(c)][detail::LINE_TABLES<Size>.slots[dir][idx].line]; }
+    // All line words of a color (indexed by line id)
+    const std::array<uint32_t, LINES>& lines(Cell c) const { return words[colorIndex(c)]; }
+
+    // True when c has five or more in a row somewhere (tracked by set/reset)
+    bool hasFive(Cell c) const { return fiveLines[colorIndex(c)] != 0; }
+
+    // hasFive(c) with the stones ids[0..n) of c lifted (n <= MAX_LIFTED); the words are left untouched
+    static constexpr int MAX_LIFTED = 16;
+    bool hasFiveWithout(Cell c, const uint16_t* ids, int n) const
+    {
+        const int ci = colorIndex(c);
+        std::array<uint16_t, DIRS * MAX_LIFTED> touched;
+        std::array<uint32_t, DIRS * MAX_LIFTED> lifted;
+        int k = 0;
+        for (int i = 0; i < n; ++i)
+            for (int d = 0; d < DIRS; ++d) {
+                const Slot s = detail::LINE_TABLES<Size>.slots[d][ids[i]];
+                int j = 0;
+                while (j < k && touched[j] != s.line)
+                    ++j;
+                if (j == k) {
+                    touched[k] = s.line;
+                    lifted[k++] = 0;
+                }
+                lifted[j] |= 1u << s.bit;
+            }
+        int lost = 0;
+        for (int j = 0; j < k; ++j) {
+            const uint32_t w = words[ci][touched[j]];
+            lost += fiveStarts(w) != 0 && fiveStarts(w & ~lifted[j]) == 0;
+        }
+        return fiveLines[ci] > lost;
+    }
+
+    // Bit i of the result is set when the 5 bits i..i+4 of w are set
+    static constexpr uint32_t fiveStarts(uint32_t w) { return w & (w >> 1) & (w >> 2) & (w >> 3) & (w >> 4); }
+
+private:
+    static constexpr int colorIndex(Cell c) { return c == Cell::Black ? 0 : 1; }
+
+    static_assert(PAD + Size + PAD <= 32, "line words must fit in 32 bits");
+
+    std::array<std::array<uint32_t, LINES>, 2> words {};
+    std::array<int, 2> fiveLines {}; // lines holding a five, per color
+};
+
+using Bitboard = BasicBitboard<BOARD_SIZE>;
+
+} // namespace gomoku
@@ -1,18 +1,46 @@
 #pragma once
+#include "gomoku/core/Bitboard.hpp"
+#include "gomoku/core/CellSet.hpp"
+#include "gomoku/core/LineScanner.hpp"
+#include "gomoku/core/Mailbox.hpp"
+#include "gomoku/core/MoveList.hpp"
+#include "gomoku/core/PackedLines.hpp"
 #include "gomoku/core/Types.hpp"
+#include "gomoku/core/Zobrist.hpp"
 #include "gomoku/interfaces/IBoardView.hpp"
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace gomoku {
 
+template <int Size>
+class BasicSearchBoard;
+
+namespace detail {
+    // True when the mover's stone at the (implicit) center of an 11-cell window in
+    // PackedLines::relativeWindow codes forms a free three (table built in Board.cpp)
+    bool isFreeThreeWindow(uint32_t window);
+}
+
 // Implémentation concrète de IBoardView pour libgomoku_logic.a
-class Board final : public IBoardView {
+//
+// Templated on the board size so that index math and every line/neighbour/Zobrist
+// table is a compile-time constant per size. Instantiated in Board.cpp for the
+// standard 19x19 board (Board) and for 15x15.
+template <int Size>
+class BasicBoard final : public IBoardView {
 public:
-    Board();
+    static constexpr int SIZE = Size;
+    using Bitboard = BasicBitboard<Size>;
+    using PackedLines = BasicPackedLines<Size>;
+    using CellSet = BasicCellSet<Size>;
+    using Mailbox = BasicMailbox<Size>;
+
+    BasicBoard();
 
     // ---- IBoardView interface ----
     Cell at(uint8_t x, uint8_t y) const override;
@@ -21,12 +49,20 @@ public:
     GameStatus status() const override { return gameState; }
     bool isBoardFull() const override;
     std::vector<Move> legalMoves(Player p, const RuleSet& rules) const override;
-    uint64_t zobristKey() const override { return zobristHash; }
+    // Same moves into a fixed-capacity list (no allocation), for internal callers
+    void legalMoves(Player p, const RuleSet& rules, MoveList& out) const;
+    uint64_t zobristKey() const override { return zobristSym[0]; }
+    // Key after p plays m, ignoring what m would capture (exact for non-capturing moves):
+    // lets the search prefetch the child's table entry before making the move
+    uint64_t keyAfter(Move m) const
+    {
+        return zobristSym[0] ^ detail::ZOBRIST<Size>.side ^ detail::z_of<Size>(playerToCell(m.by), idx(m.pos.x, m.pos.y));
+    }
 
     // ---- Board-specific API ----
     void reset();
-    bool isInside(uint8_t x, uint8_t y) const { return x < BOARD_SIZE && y < BOARD_SIZE; }
-    bool isEmpty(uint8_t x, uint8_t y) const { return isInside(x, y) && cells[idx(x, y)] == Cell::Empty; }
+    bool isInside(uint8_t x, uint8_t y) const { return x < Size && y < Size; }
+    bool isEmpty(uint8_t x, uint8_t y) const { return isInside(x, y) && mail.at(idx(x, y)) == Cell::Empty; }
 
     // Stone count (tracked incrementally)
     int stoneCount(Player p) const { return (p == Player::Black) ? blackStones : whiteStones; }
@@ -52,11 +88,44 @@ public:
         }
         return out;
     }
+    // Same moves into a fixed-capacity list (no allocation), for the search
+    void lastMoves(std::size_t k, MoveList& out) const
+    {
+        out.clear();
+        const std::size_t n = std::min(k, moveHistory.size());
+        for (std::size_t i = 0; i < n; ++i)
+            out.push_back(moveHistory[moveHistory.size() - 1 - i].move.pos);
+    }
 
+    // Validates and plays m in a single pass of the rule engine
     PlayResult tryPlay(Move m, const RuleSet& rules);
+    // Read-only legality query: the PlayResult tryPlay would return, without playing
+    PlayResult checkMove(Move m, const RuleSet& rules) const;
     bool undo();
 
-    bool speculativeTry(Move m, const RuleSet& rules, PlayResult* out);
+    // Trusted make/unmake for search: m must be legal for the side to move (empty cell,
+    // game ongoing, rules already checked, e.g. taken from legalMoves). No validation is done;
+    // captures, status and history are updated exactly as tryPlay would.
+    void doMove(Move m, const RuleSet& rules);
+    // Reverts the last doMove/tryPlay; the history must not be empty.
+    void undoMove();
+
+    // Same rule engine specialized for one rule variant (V must be rules.variant()).
+    // Callers playing many moves under fixed rules (the search) choose V once with
+    // withRuleVariant; the untemplated calls above dispatch on every call.
+    template <RuleVariant V>
+    PlayResult tryPlayFor(Move m, const RuleSet& rules);
+    template <RuleVariant V>
+    PlayResult checkMoveFor(Move m, const RuleSet& rules) const;
+    template <RuleVariant V>
+    void doMoveFor(Move m, const RuleSet& rules);
+    template <RuleVariant V>
+    CellSet legalMaskFor(Player p, const RuleSet& rules) const;
+    template <RuleVariant V>
+    void legalMovesFor(Player p, const RuleSet& rules, MoveList& out) const;
+
+    // Legacy wrapper around checkMove
+    bool speculativeTry(Move m, const RuleSet& rules, PlayResult* out) const;
 
     // Legacy API for compatibility
     bool play(Move m, const RuleSet& rules, std::string* whyNot = nullptr)
@@ -72,49 +141,256 @@ public:
 
     // Sparse occupied cells accessor (for fast scans in generators/eval)
     const std::vector<Pos>& occupiedPositions() const { return occupied_; }
+    // Empty cells within Chebyshev distance 2 of a stone (maintained incrementally)
+    const std::vector<Pos>& frontierPositions() const { return frontier_; }
+
+    // Empty cells where p would make an illegal double-three under rules (maintained incrementally)
+    const CellSet& doubleThreeMask(Player p, const RuleSet& rules) const;
+    // Cells where p may legally play now (as checkMove would accept with p to move):
+    // empty, not a forbidden double-three and, when the opponent holds a breakable
+    // five, only the captures that break it. Empty once the game is over.
+    CellSet legalMask(Player p, const RuleSet& rules) const;
+
+    // ---- Capture threats (refreshed on query, whatever the rules) ----
+    // The rule engine only reads them for variants with captures.
+    // Empty cells where p playing now captures at least one pair (X O O _ shapes)
+    const CellSet& captureMask(Player p) const
+    {
+        refreshLines<CAPTURE_INDEX>();
+        return captureCells_[colorIndex(p)];
+    }
+    // Directions of those captures at pos: bit 2*d for +DX[d], bit 2*d+1 for -DX[d] (0 if none)
+    uint8_t captureDirs(Pos pos, Player p) const
+    {
+        refreshLines<CAPTURE_INDEX>();
+        return captureDirs_[colorIndex(p)][idx(pos.x, pos.y)];
+    }
+    // Stones of p in a pair the opponent can capture with one move, and the number of such pairs
+    const CellSet& exposedStones(Player p) const
+    {
+        refreshLines<CAPTURE_INDEX>();
+        return exposed_[colorIndex(p)];
+    }
+    int exposedPairs(Player p) const
+    {
+        refreshLines<CAPTURE_INDEX>();
+        return exposedPairs_[colorIndex(p)];
+    }
+
+    // ---- Dihedral symmetries ----
+    // t = 0 identity, 1..3 rotations by 90/180/270 degrees, 4 mirror x, 5 mirror y,
+    // 6 transpose (x <-> y), 7 anti-transpose.
+    static constexpr int SYMMETRIES = 8;
+    static constexpr Pos transform(Pos p, int t)
+    {
+        const uint8_t x = p.x, y = p.y, rx = static_cast<uint8_t>(Size - 1 - p.x), ry = static_cast<uint8_t>(Size - 1 - p.y);
+        switch (t) {
+        case 1:
+            return { ry, x };
+        case 2:
+            return { rx, ry };
+        case 3:
+            return { y, rx };
+        case 4:
+            return { rx, y };
+        case 5:
+            return { x, ry };
+        case 6:
+            return { y, x };
+        case 7:
+            return { ry, rx };
+        default:
+            return p;
+        }
+    }
+    // Transform undoing t (rotations by 90 and 270 swap, the others are involutions)
+    static constexpr int inverseTransform(int t) { return t == 1 ? 3 : (t == 3 ? 1 : t); }
+
+    // Zobrist key of the position seen through transform t (symmetryKey(0) == zobristKey())
+    uint64_t symmetryKey(int t) const { return zobristSym[t]; }
+    // Smallest of the 8 symmetry keys: equal for all rotated/mirrored versions of a position
+    uint64_t canonicalKey() const { return zobristSym[canonicalTransform()]; }
+    // Transform t whose key is the canonical one. A move m of this position maps to
+    // transform(m.pos, t) in the canonical frame, and back with inverseTransform(t).
+    int canonicalTransform() const
+    {
+        int best = 0;
+        for (int t = 1; t < SYMMETRIES; ++t)
+            if (zobristSym[t] < zobristSym[best])
+                best = t;
+        return best;
+    }
+
+    // Runs of p over every row, column and diagonal (one vectorized pass, see LineScanner)
+    RunCounts runCounts(Player p) const
+    {
+        const Cell me = playerToCell(p), op = playerToCell(opponent(p));
+        return linescan::countRuns(bb.lines(me).data(), bb.lines(op).data(), Bitboard::walls().data(), Bitboard::LINES);
+    }
+
+    // Line representations (read-only) for table-driven pattern scans
+    const Bitboard& bitboard() const { return bb; }
+    const PackedLines& packedLines() const { return packed; }
+    const Mailbox& mailbox() const { return mail; }
 
 private:
-    static constexpr int N = BOARD_SIZE * BOARD_SIZE;
-    static constexpr uint16_t idx(uint8_t x, uint8_t y) { return static_cast<uint16_t>(y * BOARD_SIZE + x); }
+    friend class BasicSearchBoard<Size>; // builds a Board from a compact position
 
-    std::array<Cell, N> cells {};
+    static constexpr int N = Size * Size;
+    static constexpr uint16_t idx(uint8_t x, uint8_t y) { return static_cast<uint16_t>(y * Size + x); }
+    static constexpr Pos posOf(uint16_t id) { return { static_cast<uint8_t>(id % Size), static_cast<uint8_t>(id / Size) }; }
+    static constexpr int colorIndex(Player p) { return p == Player::Black ? 0 : 1; }
+
+    // Per-color rotated bitboards (rows, columns, diagonals)
+    Bitboard bb;
+    // Same lines, 2 bits per cell (both colors + walls in one word)
+    PackedLines packed;
+    // Same cells again, one byte each on a wall-padded grid (bounds-free neighbour walks)
+    Mailbox mail;
 
     Player currentPlayer { Player::Black };
     int blackPairs { 0 }, whitePairs { 0 };
     int blackStones { 0 }, whiteStones { 0 }; // tracked counts
     GameStatus gameState { GameStatus::Ongoing };
 
+    // A move captures at most one pair per direction and sense: 8 pairs, 16 stones
+    static constexpr int MAX_CAPTURED = 16;
+    static_assert(MAX_CAPTURED <= Bitboard::MAX_LIFTED, "captureBreaksFive lifts up to MAX_CAPTURED stones");
+    // Initial capacity of the undo stack (grows only for games longer than this)
+    static constexpr std::size_t HISTORY_RESERVE = 2 * N;
+
     struct UndoEntry {
         Move move {};
-        std::vector<Pos> capturedStones; // pierres capturées
+        std::array<Pos, MAX_CAPTURED> capturedStones {}; // pierres capturées
+        uint8_t capturedCount { 0 };
         int blackPairsBefore { 0 }, whitePairsBefore { 0 };
         int blackStonesBefore { 0 }, whiteStonesBefore { 0 };
         GameStatus stateBefore { GameStatus::Ongoing };
         Player playerBefore { Player::Black };
+        // Line caches as the move found them: stale cells and the trail length
+        CellSet staleThreesBefore {}, staleCapturesBefore {};
+        uint32_t trailBefore { 0 };
     };
-    std::vector<UndoEntry> moveHistory;
+    std::vector<UndoEntry> moveHistory; // fixed-size entries, capacity reserved up front
 
     // --- Sparse index for occupied cells ---
     std::vector<Pos> occupied_; // list of occupied positions (both colors)
+    CellSet stones_ {}; // same cells as a bit set (both colors)
     std::array<int16_t, N> occIdx_ {}; // map linear index -> index in occupied_, -1 if empty
 
-    static_assert(BOARD_SIZE * BOARD_SIZE < std::numeric_limits<int16_t>::max(), "occIdx_ requires N < int16_t::max");
+    static_assert(Size * Size < std::numeric_limits<int16_t>::max(), "occIdx_ requires N < int16_t::max");
+
+    // --- Frontier: empty cells near stones (5x5 box, Mailbox::box), with reference counts ---
+    std::vector<Pos> frontier_; // empty cells with nearStones_ > 0
+    std::array<int16_t, N> frontierIdx_ {}; // map linear index -> index in frontier_, -1 if absent
+    std::array<uint8_t, N> nearStones_ {}; // stones within the 5x5 box centered on the cell
+
+    // --- Double-three masks, per color (index 0 = Black) ---
+    // Plain: the move forms two free threes. Capt: same, minus moves that capture
+    // (exempt when captures are enabled). Moves only collect the cells whose +-5 line
+    // windows changed in staleThrees_ (and staleCaptures_ for the capture index); the
+    // first query that needs them re-evaluates them (refreshLines), so make/unmake
+    // never pay for caches nobody reads, and rules without double-three or capture
+    // never pay for that cache at all.
+    // These caches are mutable: const queries may refresh them, so a Board must not
+    // be queried from several threads at once.
+    mutable std::array<CellSet, 2> forbiddenPlain_ {};
+    mutable std::array<CellSet, 2> forbiddenCapt_ {};
+    mutable CellSet staleThrees_ {};
+
+    // --- Capture threats, per color (index 0 = Black), refreshed apart from the double-threes ---
+    // captureDirs_ is the capture direction mask of each empty cell (0 elsewhere) and
+    // captureCells_ its non-zero cells. exposedRefs_ counts, per stone, the capture
+    // directions that would take it; exposed_ holds the stones with a non-zero count.
+    mutable std::array<std::array<uint8_t, N>, 2> captureDirs_ {};
+    mutable std::array<CellSet, 2> captureCells_ {};
+    mutable std::array<CellSet, 2> exposed_ {};
+    mutable std::array<uint8_t, N> exposedRefs_ {};
+    mutable std::array<int, 2> exposedPairs_ {};
+    mutable CellSet staleCaptures_ {};
+
+    // --- Trail: cache entries overwritten by refreshes, newest last ---
+    // undoMove pops the entries written since its move and restores them, which
+    // brings the caches back to their state before the move without re-evaluating.
+    struct TrailEntry {
+        uint16_t id { 0 };
+        uint8_t threes { 0 }; // bit ci: forbiddenPlain_[ci], bit 2 + ci: forbiddenCapt_[ci]
+        std::array<uint8_t, 2> dirs {}; // captureDirs_[ci]
+    };
+    static constexpr std::size_t TRAIL_RESERVE = 4096;
+    mutable std::vector<TrailEntry> trail_;
+    // Double-three bits of id, packed as in TrailEntry::threes
+    uint8_t threeBits(uint16_t id) const;
 
     // --- Zobrist hash ---
-    uint64_t zobristHash = 0;
+    // One key per dihedral transform, updated together; [0] is the plain key.
+    // Keys cover stones, side to move and both capture-pair counts.
+    std::array<uint64_t, SYMMETRIES> zobristSym {};
+    void toggleSideKey();
+    void toggleStoneKey(Cell c, uint16_t id);
+    // Sets the capture-pair counters and their Zobrist component
+    void setPairs(int black, int white);
 
-    // --- Règles / détections ---
-    bool createsIllegalDoubleThree(Move m, const RuleSet& rules) const;
+    // --- Règles / détections (spécialisées par variante de règles) ---
+    template <RuleVariant V>
+    const CellSet& doubleThreeMask(Player p) const;
+    template <RuleVariant V>
+    bool createsIllegalDoubleThree(Move m) const;
+    bool formsDoubleThree(uint16_t id, Cell me, uint8_t caps) const;
+    // Brings the caches variant V relies on up to date: the double-threes only when V
+    // forbids them, the capture index only when V has captures
+    template <RuleVariant V>
+    void refreshLines() const
+    {
+        if constexpr (V.forbidDoubleThree)
+            if (staleThrees_.any())
+                refreshThrees();
+        if constexpr (V.captures)
+            if (staleCaptures_.any())
+                refreshCaptures();
+    }
+    // Variant whose refresh covers the capture index alone (the capture queries)
+    static constexpr RuleVariant CAPTURE_INDEX { true, false, true };
+    void refreshThrees() const;
+    void refreshCaptures() const;
+    // Records the new capture directions of 'capturer' at id (exposed pair counts follow)
+    void setCaptureDirs(uint16_t id, int capturer, uint8_t dirs) const;
     bool checkFiveOrMoreFrom(Pos p, Cell who) const;
-    int applyCapturesAround(Pos p, Cell who, const RuleSet& rules, std::vector<Pos>& removed);
+    // dirs: captureDirs of the move, read before the stone is placed
+    template <RuleVariant V>
+    int applyCapturesAround(uint16_t id, Cell who, uint8_t dirs, UndoEntry& u);
 
     bool hasAnyFive(Cell who) const;
+    // Read-only checks (captured stones are masked out of the line words, no Board copy)
+    template <RuleVariant V>
     bool isFiveBreakableNow(Player justPlayed, const RuleSet& rules) const;
+    // Empty cells where the opponent of justPlayed breaks its five by capture (first one only if firstOnly)
+    template <RuleVariant V>
+    CellSet fiveBreakers(Player justPlayed, const RuleSet& rules, bool firstOnly) const;
+    template <RuleVariant V>
+    bool captureBreaksFive(uint16_t id, Cell capturer, int capturerPairs, const RuleSet& rules) const;
 
     bool wouldCapture(Move m) const;
+    // Directions in which 'who' playing at id captures a pair (index lookup)
+    uint8_t captureDirs(uint16_t id, Cell who) const;
+
+    // Pose / retrait d'une pierre (bitboards, zobrist, compteurs, index creux)
+    void putStone(uint16_t id, Cell c);
+    void takeStone(uint16_t id, Cell c);
+    void frontierAdd(uint16_t id);
+    void frontierRemove(uint16_t id);
 
-    // Facteur interne : logique partagée d'application. Si record=true, pousse UndoEntry.
+    // Facteur interne : checkMove puis applyUnchecked. Si record=true, pousse UndoEntry.
+    template <RuleVariant V>
     PlayResult applyCore(Move m, const RuleSet& rules, bool record);
+    // Pose sans validation (captures, statut, trait); pousse l'UndoEntry si record=true
+    template <RuleVariant V>
+    void applyUnchecked(Move m, const RuleSet& rules, bool record);
 };
 
+using Board = BasicBoard<BOARD_SIZE>;
+
+extern template class BasicBoard<BOARD_SIZE>;
+extern template class BasicBoard<15>;
+
 } // namespace gomoku
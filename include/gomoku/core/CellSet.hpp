@@ -0,0 +1,97 @@
+#pragma once
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace gomoku {
+
+// Fixed-size set of board cells (linear index y * Size + x), 361 bits on 19x19.
+template <int Size>
+class BasicCellSet {
+public:
+    static constexpr int CELLS = Size * Size;
+    static constexpr int WORDS = (CELLS + 63) / 64;
+
+    // Every cell of the board
+    static constexpr BasicCellSet all()
+    {
+        BasicCellSet s;
+        for (int i = 0; i < WORDS; ++i)
+            s.words[i] = (i + 1 < WORDS || CELLS % 64 == 0) ? ~0ull : (1ull << (CELLS % 64)) - 1;
+        return s;
+    }
+
+    constexpr void set(int idx) { words[idx >> 6] |= 1ull << (idx & 63); }
+    constexpr void reset(int idx) { words[idx >> 6] &= ~(1ull << (idx & 63)); }
+    constexpr void assign(int idx, bool on) { on ? set(idx) : reset(idx); }
+    constexpr bool test(int idx) const { return (words[idx >> 6] >> (idx & 63)) & 1u; }
+    constexpr void clear() { words = {}; }
+
+    constexpr bool any() const
+    {
+        for (uint64_t w : words)
+            if (w)
+                return true;
+        return false;
+    }
+
+    int count() const
+    {
+        int n = 0;
+        for (uint64_t w : words)
+            n += std::popcount(w);
+        return n;
+    }
+
+    constexpr BasicCellSet& operator|=(const BasicCellSet& o)
+    {
+        for (int i = 0; i < WORDS; ++i)
+            words[i] |= o.words[i];
+        return *this;
+    }
+
+    constexpr BasicCellSet& operator&=(const BasicCellSet& o)
+    {
+        for (int i = 0; i < WORDS; ++i)
+            words[i] &= o.words[i];
+        return *this;
+    }
+
+    // Removes the cells of o
+    constexpr BasicCellSet& subtract(const BasicCellSet& o)
+    {
+        for (int i = 0; i < WORDS; ++i)
+            words[i] &= ~o.words[i];
+        return *this;
+    }
+
+    constexpr bool operator==(const BasicCellSet&) const = default;
+
+    // Calls f(idx) for every cell in the set, in increasing index order
+    template <class F>
+    void forEach(F&& f) const
+    {
+        for (int i = 0; i < WORDS; ++i)
+            for (uint64_t w = words[i]; w; w &= w - 1)
+                f(i * 64 + std::countr_zero(w));
+    }
+
+    // Same walk, stopping at the first cell for which f(idx) returns true
+    template <class F>
+    bool anyOf(F&& f) const
+    {
+        for (int i = 0; i < WORDS; ++i)
+            for (uint64_t w = words[i]; w; w &= w - 1)
+                if (f(i * 64 + std::countr_zero(w)))
+                    return true;
+        return false;
+    }
+
+private:
+    std::array<uint64_t, WORDS> words {};
+};
+
+using CellSet = BasicCellSet<BOARD_SIZE>;
+
+} // namespace gomoku
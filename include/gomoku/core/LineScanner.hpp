@@ -0,0 +1,28 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace gomoku {
+
+// Run statistics of one color over a set of line words
+struct RunCounts {
+    // runs[len - 1][open]: runs of exactly len stones (1..4) with 0, 1 or 2 empty ends
+    std::array<std::array<int, 3>, 4> runs {};
+    int fives { 0 }; // runs of five or more (ends not counted)
+};
+
+namespace linescan {
+    // Scans n line words at once: mine[i] holds the stones of the color on line i,
+    // theirs[i] the opponent stones and walls[i] the guard bits (closed ends).
+    // Vectorized with AVX2 or SSE4.1 when the CPU supports them (picked once at
+    // runtime), scalar otherwise; all backends return the same counts.
+    RunCounts countRuns(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n);
+
+    // Kernel in use: "avx2", "sse4.1" or "scalar"
+    const char* backend();
+
+    // Portable reference kernel (also used for the tail of the vector kernels)
+    void countRunsScalar(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n, RunCounts& out);
+} // namespace linescan
+
+} // namespace gomoku
@@ -0,0 +1,119 @@
+#pragma once
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace gomoku {
+
+namespace detail {
+    inline constexpr int MAILBOX_PAD = 5;
+
+    template <int S>
+    struct MailboxTables {
+        static constexpr int W = S + 2 * MAILBOX_PAD;
+        std::array<int16_t, S * S> toPadded {}; // board index -> padded index
+        std::array<int16_t, W * W> toBoard {}; // padded index -> board index, -1 on the border
+        std::array<uint8_t, W * W> empty {}; // padded cells of an empty board (border = wall)
+    };
+
+    template <int S>
+    constexpr MailboxTables<S> makeMailboxTables()
+    {
+        constexpr int W = MailboxTables<S>::W;
+        MailboxTables<S> t {};
+        for (int i = 0; i < W * W; ++i) {
+            t.toBoard[i] = -1;
+            t.empty[i] = 3;
+        }
+        for (int y = 0; y < S; ++y)
+            for (int x = 0; x < S; ++x) {
+                const int p = (y + MAILBOX_PAD) * W + (x + MAILBOX_PAD);
+                t.toPadded[y * S + x] = static_cast<int16_t>(p);
+                t.toBoard[p] = static_cast<int16_t>(y * S + x);
+                t.empty[p] = 0;
+            }
+        return t;
+    }
+
+    template <int S>
+    inline constexpr MailboxTables<S> MAILBOX_TABLES = makeMailboxTables<S>();
+
+    // In-board cells of the 5x5 box around each cell (the cell itself excluded)
+    template <int S>
+    struct BoxNeighbours {
+        std::array<uint8_t, S * S> count {};
+        std::array<std::array<uint16_t, 24>, S * S> ids {};
+    };
+
+    template <int S>
+    constexpr BoxNeighbours<S> makeBoxNeighbours()
+    {
+        BoxNeighbours<S> t {};
+        for (int y = 0; y < S; ++y)
+            for (int x = 0; x < S; ++x)
+                for (int dy = -2; dy <= 2; ++dy)
+                    for (int dx = -2; dx <= 2; ++dx) {
+                        const int nx = x + dx, ny = y + dy;
+                        if ((dx || dy) && nx >= 0 && nx < S && ny >= 0 && ny < S)
+                            t.ids[y * S + x][t.count[y * S + x]++] = static_cast<uint16_t>(ny * S + nx);
+                    }
+        return t;
+    }
+
+    template <int S>
+    inline constexpr BoxNeighbours<S> BOX_NEIGHBOURS = makeBoxNeighbours<S>();
+} // namespace detail
+
+// Sentinel-padded mailbox.
+//
+// One byte per cell (0 empty, 1 black, 2 white, same codes as PackedLines) on a
+// (Size + 2*PAD)^2 grid whose border holds WALL. A ray of up to PAD steps from
+// any board cell, p + k * OFFSET[d], therefore stays inside the array and reads
+// WALL once it leaves the board: walks need no bounds checks, only a compare
+// against the code they are looking for.
+template <int Size>
+class BasicMailbox {
+public:
+    static constexpr int PAD = detail::MAILBOX_PAD;
+    static constexpr int WIDTH = Size + 2 * PAD;
+    static constexpr uint8_t EMPTY = 0, BLACK = 1, WHITE = 2, WALL = 3;
+
+    // 8 directions: the 4 line directions (as in Bitboard) then their opposites
+    static constexpr int DIRS = 8;
+    static constexpr int DX[DIRS] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+    static constexpr int DY[DIRS] = { 0, 1, 1, -1, 0, -1, -1, 1 };
+    static constexpr int OFFSET[DIRS] = { 1, WIDTH, WIDTH + 1, 1 - WIDTH, -1, -WIDTH, -WIDTH - 1, WIDTH - 1 };
+
+    static constexpr uint8_t code(Cell c) { return c == Cell::Black ? BLACK : (c == Cell::White ? WHITE : EMPTY); }
+
+    // Board index <-> padded index
+    static constexpr int padded(int id) { return detail::MAILBOX_TABLES<Size>.toPadded[id]; }
+    static constexpr int padded(int x, int y) { return (y + PAD) * WIDTH + (x + PAD); }
+    static constexpr int boardIndex(int p) { return detail::MAILBOX_TABLES<Size>.toBoard[p]; }
+
+    // Board cells of the 5x5 box around a board cell (itself excluded)
+    static constexpr int boxCount(int id) { return detail::BOX_NEIGHBOURS<Size>.count[id]; }
+    static constexpr const std::array<uint16_t, 24>& box(int id) { return detail::BOX_NEIGHBOURS<Size>.ids[id]; }
+
+    BasicMailbox() { clear(); }
+
+    void clear() { cells = detail::MAILBOX_TABLES<Size>.empty; }
+    void set(Cell c, int id) { cells[padded(id)] = code(c); }
+    void reset(int id) { cells[padded(id)] = EMPTY; }
+
+    // Code at a padded index (WALL outside the board)
+    uint8_t operator[](int p) const { return cells[p]; }
+
+    Cell at(int id) const
+    {
+        const uint8_t v = cells[padded(id)];
+        return v == BLACK ? Cell::Black : (v == WHITE ? Cell::White : Cell::Empty);
+    }
+
+private:
+    std::array<uint8_t, WIDTH * WIDTH> cells {};
+};
+
+using Mailbox = BasicMailbox<BOARD_SIZE>;
+
+} // namespace gomoku
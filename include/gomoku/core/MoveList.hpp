@@ -0,0 +1,127 @@
+#pragma once
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace gomoku {
+
+// 16-bit move for internal use: cell index (y * BOARD_SIZE + x) in the low
+// 9 bits, flags above. The player is not stored: it is the side to move of
+// the position the move belongs to, and is given back when converting to Move.
+class PackedMove {
+public:
+    static constexpr uint16_t INDEX_BITS = 9;
+    static constexpr uint16_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint16_t NONE = INDEX_MASK; // no move (index 511)
+
+    // Flags (free for move generators and ordering)
+    static constexpr uint16_t CAPTURE = 1u << 9;
+    static constexpr uint16_t THREAT = 1u << 10;
+
+    static_assert(BOARD_SIZE * BOARD_SIZE < NONE, "cell index must fit in INDEX_BITS");
+
+    // Trivial (uninitialized) so that a MoveList costs nothing to create; use none() for "no move"
+    PackedMove() = default;
+    constexpr explicit PackedMove(Pos p, uint16_t flags = 0)
+        : bits(static_cast<uint16_t>(p.toIndex() | flags))
+    {
+    }
+    constexpr explicit PackedMove(const Move& m)
+        : PackedMove(m.pos)
+    {
+    }
+
+    static constexpr PackedMove fromIndex(uint16_t idx, uint16_t flags = 0) { return PackedMove(static_cast<uint16_t>(idx | flags), RawTag {}); }
+    static constexpr PackedMove none() { return PackedMove(NONE, RawTag {}); }
+
+    constexpr uint16_t index() const { return bits & INDEX_MASK; }
+    constexpr Pos pos() const { return Pos::fromIndex(index()); }
+    constexpr Move toMove(Player by) const { return Move { pos(), by }; }
+    constexpr uint16_t flags() const { return static_cast<uint16_t>(bits & ~INDEX_MASK); }
+    constexpr bool has(uint16_t flag) const { return (bits & flag) != 0; }
+    constexpr void addFlags(uint16_t flag) { bits |= flag; }
+    constexpr bool isNone() const { return index() == NONE; }
+    constexpr uint16_t raw() const { return bits; }
+
+    // Same cell (flags ignored)
+    constexpr bool operator==(const PackedMove& o) const { return index() == o.index(); }
+
+private:
+    struct RawTag { };
+    constexpr PackedMove(uint16_t raw, RawTag)
+        : bits(raw)
+    {
+    }
+
+    uint16_t bits;
+};
+
+static_assert(sizeof(PackedMove) == 2 && std::is_trivial_v<PackedMove>, "PackedMove must stay a trivial 16-bit value");
+
+// Fixed-capacity move list on the stack: one slot per board cell, never allocates.
+class MoveList {
+public:
+    static constexpr int CAPACITY = BOARD_SIZE * BOARD_SIZE;
+
+    void push_back(PackedMove m)
+    {
+        assert(count < CAPACITY);
+        moves[count++] = m;
+    }
+    void push_back(Pos p) { push_back(PackedMove(p)); }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == CAPACITY; }
+    void clear() { count = 0; }
+    // Keeps the first n moves (n <= size())
+    void truncate(int n)
+    {
+        if (n < count)
+            count = static_cast<uint16_t>(n);
+    }
+
+    PackedMove& operator[](int i) { return moves[i]; }
+    const PackedMove& operator[](int i) const { return moves[i]; }
+
+    PackedMove* begin() { return moves.data(); }
+    PackedMove* end() { return moves.data() + count; }
+    const PackedMove* begin() const { return moves.data(); }
+    const PackedMove* end() const { return moves.data() + count; }
+
+    bool contains(PackedMove m) const
+    {
+        for (const PackedMove& x : *this)
+            if (x == m)
+                return true;
+        return false;
+    }
+
+    // Public API boundary: heap vector of full moves for player 'by'
+    std::vector<Move> toMoves(Player by) const
+    {
+        std::vector<Move> out;
+        out.reserve(count);
+        for (const PackedMove& m : *this)
+            out.push_back(m.toMove(by));
+        return out;
+    }
+
+    static MoveList fromMoves(const std::vector<Move>& v)
+    {
+        MoveList out;
+        for (const Move& m : v)
+            if (!out.full())
+                out.push_back(PackedMove(m));
+        return out;
+    }
+
+private:
+    std::array<PackedMove, CAPACITY> moves;
+    uint16_t count { 0 };
+};
+
+} // namespace gomoku
@@ -0,0 +1,149 @@
+#pragma once
+#include "gomoku/core/Bitboard.hpp"
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace gomoku {
+
+namespace detail {
+    // Run shape read from a 7-cell window [start-1 .. start+5] of a packed line:
+    // bits 0..2 = run length of the stone at start (capped at 5), bits 3..4 = open ends.
+    constexpr std::array<uint8_t, 1u << 14> makeRunShapes()
+    {
+        std::array<uint8_t, 1u << 14> t {};
+        for (uint32_t w = 0; w < t.size(); ++w) {
+            auto cell = [&](int i) { return (w >> (2 * i)) & 3u; };
+            const uint32_t c = cell(1);
+            if (c != 1u && c != 2u)
+                continue;
+            int len = 1;
+            while (len < 5 && cell(1 + len) == c)
+                ++len;
+            int open = cell(0) == 0u ? 1 : 0;
+            if (len < 5 && cell(1 + len) == 0u)
+                ++open;
+            t[w] = static_cast<uint8_t>(len | (open << 3));
+        }
+        return t;
+    }
+
+    inline constexpr std::array<uint8_t, 1u << 14> RUN_SHAPES = makeRunShapes();
+
+    // Empty packed lines: guard cells (outside the board) hold the wall code 3
+    template <int S>
+    constexpr std::array<uint64_t, lineCount(S)> makePackedWallWords()
+    {
+        using BB = BasicBitboard<S>;
+        std::array<uint64_t, lineCount(S)> t {};
+        for (int line = 0; line < BB::LINES; ++line)
+            for (int b = 0; b < 2 * BB::PAD + S; ++b)
+                if ((BB::wall(line) >> b) & 1u)
+                    t[line] |= 3ull << (2 * b);
+        return t;
+    }
+
+    template <int S>
+    inline constexpr std::array<uint64_t, lineCount(S)> PACKED_WALL_WORDS = makePackedWallWords<S>();
+} // namespace detail
+
+// Packed 2-bit-per-cell line words.
+//
+// Companion of Bitboard: each row, column and diagonal is one 64-bit word where
+// a cell takes 2 bits (0 empty, 1 black, 2 white, 3 wall). Both colors live in
+// the same word, so a window of n cells is a single shift-and-mask and shapes
+// involving both colors (captures, runs with their ends) are one compare or one
+// table lookup. Cell positions match Bitboard slots; guard cells hold WALL.
+template <int Size>
+class BasicPackedLines {
+    using Bitboard = BasicBitboard<Size>;
+
+public:
+    static constexpr uint32_t EMPTY = 0, BLACK = 1, WHITE = 2, WALL = 3;
+
+    static constexpr uint32_t code(Cell c) { return c == Cell::Black ? BLACK : (c == Cell::White ? WHITE : EMPTY); }
+
+    BasicPackedLines() { clear(); }
+
+    void clear() { words = detail::PACKED_WALL_WORDS<Size>; }
+
+    void set(Cell c, int idx)
+    {
+        const uint64_t v = code(c);
+        for (int d = 0; d < Bitboard::DIRS; ++d) {
+            const auto s = Bitboard::slot(d, idx);
+            words[s.line] |= v << (2 * s.bit);
+        }
+    }
+
+    void reset(int idx)
+    {
+        for (int d = 0; d < Bitboard::DIRS; ++d) {
+            const auto s = Bitboard::slot(d, idx);
+            words[s.line] &= ~(3ull << (2 * s.bit));
+        }
+    }
+
+    uint64_t word(int line) const { return words[line]; }
+    uint64_t line(int dir, int idx) const { return words[Bitboard::slot(dir, idx).line]; }
+
+    // n consecutive cells of a line word starting at slot bit 'from' (cell 'from' in the low bits)
+    static constexpr uint32_t window(uint64_t w, int from, int n)
+    {
+        return static_cast<uint32_t>((w >> (2 * from)) & ((1ull << (2 * n)) - 1ull));
+    }
+
+    // Directions in which 'who' playing at idx captures a pair (XOOX):
+    // bit 2*d for +DX[d], bit 2*d+1 for -DX[d]. Shapes of 3 cells, one compare per sense.
+    uint8_t captureDirs(int idx, Cell who) const
+    {
+        const uint32_t me = code(who);
+        const uint32_t op = me ^ 3u; // BLACK <-> WHITE
+        const uint32_t plusShape = op | (op << 2) | (me << 4); // b+1, b+2, b+3 = op, op, me
+        const uint32_t minusShape = me | (op << 2) | (op << 4); // b-3, b-2, b-1 = me, op, op
+        uint8_t dirs = 0;
+        for (int d = 0; d < Bitboard::DIRS; ++d) {
+            const auto s = Bitboard::slot(d, idx);
+            const uint64_t w = words[s.line];
+            if (window(w, s.bit + 1, 3) == plusShape)
+                dirs |= static_cast<uint8_t>(1u << (2 * d));
+            if (window(w, s.bit - 3, 3) == minusShape)
+                dirs |= static_cast<uint8_t>(1u << (2 * d + 1));
+        }
+        return dirs;
+    }
+
+    // 11 cells (k = -5..5) around idx along dir, with codes relative to 'me':
+    // 1 = me, 2 = opponent (WHITE and BLACK swapped when me is white), 0 empty, 3 wall.
+    uint32_t relativeWindow(int dir, int idx, Cell me) const
+    {
+        const auto s = Bitboard::slot(dir, idx);
+        uint32_t w = window(words[s.line], s.bit - Bitboard::PAD, 11);
+        if (me == Cell::White) {
+            const uint32_t diff = (w ^ (w >> 1)) & 0x155555u; // codes 1 and 2
+            w ^= diff | (diff << 1);
+        }
+        return w;
+    }
+
+    struct RunShape {
+        int len; // 1..5 (5 means five or more)
+        int open; // empty cells at the two ends (walls and stones close a run)
+    };
+
+    // Shape of the run starting at slot bit 'start' (the cell before it must not hold the same color)
+    static RunShape runShape(uint64_t w, int start)
+    {
+        const uint8_t v = detail::RUN_SHAPES[window(w, start - 1, 7)];
+        return { v & 7, v >> 3 };
+    }
+
+private:
+    static_assert(2 * (2 * Bitboard::PAD + Size) <= 64, "packed line words must fit in 64 bits");
+
+    std::array<uint64_t, Bitboard::LINES> words {};
+};
+
+using PackedLines = BasicPackedLines<BOARD_SIZE>;
+
+} // namespace gomoku
@@ -0,0 +1,96 @@
+#pragma once
+#include "gomoku/core/Board.hpp"
+#include "gomoku/core/PackedLines.hpp"
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace gomoku {
+
+// Compact, trivially copyable position for copy-make search and worker threads.
+//
+// Holds only the packed line words (2 bits per cell, both colors and walls),
+// capture counts, stone counts, side to move, status and Zobrist key: no heap
+// member, so a copy is one memcpy of about 900 bytes on 19x19 and each thread
+// can own its positions. The rules are the Board ones (captures, breakable
+// five, capture win, double-three), evaluated on the packed lines, and the key
+// matches Board::zobristKey(). There is no undo: play() on a copy and drop it.
+// Converts from a Board and back; the Board built by toBoard() has no history.
+template <int Size>
+class BasicSearchBoard {
+    using Board = BasicBoard<Size>;
+    using Bitboard = BasicBitboard<Size>;
+    using PackedLines = BasicPackedLines<Size>;
+
+public:
+    static constexpr int CELLS = Size * Size;
+
+    BasicSearchBoard()
+        : BasicSearchBoard(Board {})
+    {
+    }
+    explicit BasicSearchBoard(const Board& b);
+
+    Board toBoard() const;
+
+    Cell at(uint8_t x, uint8_t y) const { return at(y * Size + x); }
+    Cell at(int id) const
+    {
+        const auto s = Bitboard::slot(0, id);
+        const uint32_t c = PackedLines::window(packed.word(s.line), s.bit, 1);
+        return c == PackedLines::BLACK ? Cell::Black : (c == PackedLines::WHITE ? Cell::White : Cell::Empty);
+    }
+    Player toPlay() const { return side; }
+    GameStatus status() const { return state; }
+    CaptureCount capturedPairs() const { return { pairs[0], pairs[1] }; }
+    int stoneCount(Player p) const { return stones[p == Player::Black ? 0 : 1]; }
+    uint64_t zobristKey() const { return key; }
+    const PackedLines& packedLines() const { return packed; }
+
+    // Same verdict as Board::checkMove(m, rules).success
+    bool isLegal(Move m, const RuleSet& rules) const;
+
+    // Trusted make, as Board::doMove: m must be legal for the side to move.
+    // Captures, status, counters and key are updated exactly as on a Board.
+    void play(Move m, const RuleSet& rules);
+
+    // Same, specialized for the rule variant V == rules.variant() (see withRuleVariant)
+    template <RuleVariant V>
+    bool isLegalFor(Move m, const RuleSet& rules) const;
+    template <RuleVariant V>
+    void playFor(Move m, const RuleSet& rules);
+
+private:
+    static constexpr int colorIndex(Cell c) { return c == Cell::Black ? 0 : 1; }
+
+    void putStone(int id, Cell c);
+    void takeStone(int id, Cell c);
+    void setPairs(int ci, int value);
+
+    bool hasFive(Cell c) const;
+    bool fiveThrough(int id, Cell c) const;
+    // Does 'capturer' playing at id break every five of the other color?
+    bool captureBreaksFive(int id, Cell capturer, const RuleSet& rules) const;
+    // Can 'capturer' break the five of the other color right now?
+    template <RuleVariant V>
+    bool fiveBreakable(Cell capturer, const RuleSet& rules) const;
+    bool formsDoubleThree(int id, Cell me, uint8_t caps) const;
+
+    PackedLines packed;
+    uint64_t key { 0 };
+    std::array<int16_t, 2> stones {};
+    std::array<int16_t, 2> pairs {};
+    std::array<bool, 2> five {}; // the color has five or more in a row somewhere
+    Player side { Player::Black };
+    GameStatus state { GameStatus::Ongoing };
+};
+
+using SearchBoard = BasicSearchBoard<BOARD_SIZE>;
+
+static_assert(std::is_trivially_copyable_v<SearchBoard>, "SearchBoard must stay memcpy-copyable");
+
+extern template class BasicSearchBoard<BOARD_SIZE>;
+extern template class BasicSearchBoard<15>;
+
+} // namespace gomoku
@@ -10,7 +10,8 @@
 
 namespace gomoku {
 
-// Board size (19x19 standard Gomoku)
+// Board size (19x19 standard Gomoku). The core (BasicBoard<Size>) is templated on it;
+// Board, the application layer and the GUI use this default size.
 inline constexpr int BOARD_SIZE = 19;
 
 // Represents a player in the game
@@ -81,14 +82,72 @@ struct Move {
     }
 };
 
+// Rule flags that select code paths in the rule engine (usable as a template argument).
+// Board, SearchBoard and the search instantiate their hot path once per variant and
+// pick it once from the RuleSet (withRuleVariant): no per-move branch on unused rules.
+struct RuleVariant {
+    bool captures = true;
+    bool forbidDoubleThree = true;
+    bool alignWins = true; // RuleSet::allowFiveOrMore
+
+    static constexpr int COUNT = 8;
+    constexpr int index() const noexcept { return (captures ? 1 : 0) | (forbidDoubleThree ? 2 : 0) | (alignWins ? 4 : 0); }
+    static constexpr RuleVariant fromIndex(int i) noexcept { return { (i & 1) != 0, (i & 2) != 0, (i & 4) != 0 }; }
+};
+
 // Represents the rules of the game
 struct RuleSet {
     bool forbidDoubleThree = true;
     bool allowFiveOrMore = true;
     bool capturesEnabled = true;
     uint8_t captureWinPairs = 5; // 5 pairs = 10 stones
+
+    constexpr RuleVariant variant() const noexcept { return { capturesEnabled, forbidDoubleThree, allowFiveOrMore }; }
+
+    // Presets offered to players
+    static constexpr RuleSet standard() noexcept { return {}; }
+    // Five in a row only: no captures, hence no capture win; double-threes stay forbidden
+    static constexpr RuleSet noCaptures() noexcept
+    {
+        RuleSet r;
+        r.capturesEnabled = false;
+        return r;
+    }
+    // Free-style gomoku: five or more wins, no captures and no double-three restriction
+    static constexpr RuleSet freeStyle() noexcept
+    {
+        RuleSet r;
+        r.capturesEnabled = false;
+        r.forbidDoubleThree = false;
+        return r;
+    }
 };
 
+// Runs f.template operator()<V>() for the variant v: a single switch, then code
+// specialized for V (f is typically a lambda []<RuleVariant V>() { ... }).
+template <class F>
+decltype(auto) withRuleVariant(RuleVariant v, F&& f)
+{
+    switch (v.index()) {
+    case 0:
+        return f.template operator()<RuleVariant::fromIndex(0)>();
+    case 1:
+        return f.template operator()<RuleVariant::fromIndex(1)>();
+    case 2:
+        return f.template operator()<RuleVariant::fromIndex(2)>();
+    case 3:
+        return f.template operator()<RuleVariant::fromIndex(3)>();
+    case 4:
+        return f.template operator()<RuleVariant::fromIndex(4)>();
+    case 5:
+        return f.template operator()<RuleVariant::fromIndex(5)>();
+    case 6:
+        return f.template operator()<RuleVariant::fromIndex(6)>();
+    default:
+        return f.template operator()<RuleVariant::fromIndex(7)>();
+    }
+}
+
 // Represents captured stone pairs count
 struct CaptureCount {
     int black = 0;
@@ -0,0 +1,59 @@
+#pragma once
+#include "gomoku/core/Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace gomoku::detail {
+
+// Zobrist keys shared by Board and SearchBoard, generated at compile time per
+// board size (fixed seed, reproducible across runs and builds).
+
+// splitmix64 generator, usable in constant expressions
+constexpr uint64_t splitmix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Keys for the capture-pair counters: 0..PAIR_KEYS-1 (the counter wraps beyond)
+inline constexpr int PAIR_KEYS = 32;
+
+template <int S>
+struct ZobristTables {
+    std::array<uint64_t, 2 * S * S> pcs {}; // [color][cell]
+    uint64_t side { 0 };
+    std::array<uint64_t, 2 * PAIR_KEYS> pairs {}; // [color][pairs]
+};
+
+template <int S>
+constexpr ZobristTables<S> makeZobrist()
+{
+    ZobristTables<S> t {};
+    uint64_t state = 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(S);
+    for (auto& v : t.pcs)
+        v = splitmix64(state);
+    t.side = splitmix64(state);
+    for (auto& v : t.pairs)
+        v = splitmix64(state);
+    return t;
+}
+
+template <int S>
+inline constexpr ZobristTables<S> ZOBRIST = makeZobrist<S>();
+
+template <int S>
+constexpr uint64_t z_of(Cell c, int id)
+{
+    return ZOBRIST<S>.pcs[(c == Cell::Black ? 0 : S * S) + id];
+}
+
+// Capture-pair component (invariant under the board symmetries)
+template <int S>
+constexpr uint64_t z_pairs(int blackPairs, int whitePairs)
+{
+    return ZOBRIST<S>.pairs[blackPairs % PAIR_KEYS] ^ ZOBRIST<S>.pairs[PAIR_KEYS + whitePairs % PAIR_KEYS];
+}
+
+} // namespace gomoku::detail
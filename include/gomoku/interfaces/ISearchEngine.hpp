@@ -20,6 +20,13 @@ public:
     virtual void setTimeLimit(int milliseconds) = 0;
     virtual void setDepthLimit(int maxDepth) = 0;
     virtual void setTranspositionTableSize(size_t bytes) = 0;
+    virtual void setThreadCount(int threads) = 0; // 1 = single-threaded search
+
+    // Board synchronization: the engine keeps its own board in step with the game
+    // through these notifications, so searches on that position need no copy of the view.
+    virtual void onNewGame() = 0;
+    virtual void onMovePlayed(const Move& move, const RuleSet& rules) = 0;
+    virtual void onUndo() = 0;
 
     // MinimaxSearch operations
     virtual std::optional<Move> findBestMove(
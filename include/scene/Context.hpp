@@ -20,6 +20,7 @@ struct Context {
     bool showSettingsMenu = false;
     bool showMainMenu = false;
     bool vsAi = false;
+    bool capturesEnabled = true; // règles: false = variante sans captures
     gomoku::gui::GameBoardRenderer* boardRenderer = nullptr;
     std::string theme = "default";
     bool themeChanged = false;
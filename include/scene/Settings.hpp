@@ -20,6 +20,8 @@ private:
     void onBackClicked();
     void toggleSfx();
     void toggleMusic();
+    void toggleCaptures();
+    void savePreferences() const;
     void refreshAudioButtonsTextures();
 
     gomoku::ui::Button defaultBtn_;
@@ -29,6 +31,11 @@ private:
     gomoku::ui::Button backBtn_;
     gomoku::ui::Button sfxToggleBtn_;
     gomoku::ui::Button musicToggleBtn_;
+    gomoku::ui::Button capturesToggleBtn_;
+
+    sf::Font font_;
+    bool fontOk_ = false;
+    sf::Text capturesLabel_;
 };
 
 } // namespace gomoku::scene
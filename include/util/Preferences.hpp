@@ -6,6 +6,7 @@ namespace gomoku::util {
 struct PreferencesData {
     bool sfxEnabled = true;
     bool musicEnabled = true;
+    bool capturesEnabled = true; // false: no-capture rule variant
     std::string theme = "default";
 };
 
@@ -3,7 +3,6 @@
 #include "gomoku/core/Logger.hpp"
 #include <algorithm>
 #include <array>
-#include <bitset>
 
 namespace gomoku {
 
@@ -15,12 +14,29 @@ namespace {
     struct Rect {
         int x1, y1, x2, y2;
     };
-    struct P {
-        uint8_t x, y;
-    };
 
     constexpr int BOARD_CELLS = BOARD_SIZE * BOARD_SIZE;
 
+    // Liste de rectangles à capacité fixe (au plus un îlot par pierre): aucune allocation
+    struct RectList {
+        std::array<Rect, BOARD_CELLS> items;
+        int count = 0;
+
+        void push_back(const Rect& r) { items[count++] = r; }
+        void erase(int i)
+        {
+            std::copy(items.begin() + i + 1, items.begin() + count, items.begin() + i);
+            --count;
+        }
+        int size() const { return count; }
+        Rect& operator[](int i) { return items[i]; }
+        const Rect& operator[](int i) const { return items[i]; }
+        Rect* begin() { return items.data(); }
+        Rect* end() { return items.data() + count; }
+        const Rect* begin() const { return items.data(); }
+        const Rect* end() const { return items.data() + count; }
+    };
+
     inline bool inside(int x, int y)
     {
         return 0 <= x && x < BOARD_SIZE && 0 <= y && y < BOARD_SIZE;
@@ -41,47 +57,35 @@ namespace {
             std::min<int>(BOARD_SIZE - 1, r.y2 + m) };
     }
 
-    //-------------------------------------------
-    // Étape 0 — Collecte des pierres
-    //-------------------------------------------
-    void collectStones(const Board& b, std::vector<P>& out)
-    {
-        out.clear();
-        const auto& occ = b.occupiedPositions();
-        out.reserve(occ.size());
-        for (const auto& pos : occ)
-            out.push_back(P { pos.x, pos.y });
-    }
-
     //-------------------------------------------
     // Étape 1 — Îlots par proximité Chebyshev
     //-------------------------------------------
-    std::vector<Rect> buildIslands(const std::vector<P>& stones, uint8_t gap)
+    void buildIslands(const std::vector<Pos>& stones, uint8_t gap, RectList& rects)
     {
+        // BFS sur la liste des pierres; marques et file sur la pile (au plus une case par pierre)
         const int n = (int)stones.size();
-        std::vector<uint8_t> vis(n, 0);
-        std::vector<Rect> rects;
-        rects.reserve(16);
+        std::array<uint8_t, BOARD_CELLS> vis {};
+        std::array<uint16_t, BOARD_CELLS> q;
+        rects.count = 0;
 
-        auto nearCheb = [&](const P& a, const P& b) -> bool {
+        auto nearCheb = [&](const Pos& a, const Pos& b) -> bool {
             int dx = std::abs((int)a.x - (int)b.x);
             int dy = std::abs((int)a.y - (int)b.y);
             return std::max(dx, dy) <= gap;
         };
 
-        int islandCount = 0;
         for (int i = 0; i < n; ++i)
             if (!vis[i]) {
                 vis[i] = 1;
                 Rect r { stones[i].x, stones[i].y, stones[i].x, stones[i].y };
-                std::vector<int> q;
-                q.push_back(i);
-                for (size_t k = 0; k < q.size(); ++k) {
+                int qn = 0;
+                q[qn++] = static_cast<uint16_t>(i);
+                for (int k = 0; k < qn; ++k) {
                     int u = q[k];
                     for (int v = 0; v < n; ++v)
                         if (!vis[v] && nearCheb(stones[u], stones[v])) {
                             vis[v] = 1;
-                            q.push_back(v);
+                            q[qn++] = static_cast<uint16_t>(v);
                             r.x1 = std::min<int>(r.x1, stones[v].x);
                             r.y1 = std::min<int>(r.y1, stones[v].y);
                             r.x2 = std::max<int>(r.x2, stones[v].x);
@@ -89,25 +93,23 @@ namespace {
                         }
                 }
                 rects.push_back(r);
-                islandCount++;
             }
-        return rects;
     }
 
     //-------------------------------------------
     // Étape 2 — Fusion rectangulaire
     //-------------------------------------------
-    std::vector<Rect> mergeAll(std::vector<Rect> rs)
+    void mergeAll(RectList& rs)
     {
         int mergeCount = 0;
         bool changed = true;
         while (changed) {
             changed = false;
-            for (size_t i = 0; i < rs.size(); ++i) {
-                for (size_t j = i + 1; j < rs.size(); ++j) {
+            for (int i = 0; i < rs.size(); ++i) {
+                for (int j = i + 1; j < rs.size(); ++j) {
                     if (intersect(rs[i], rs[j])) {
                         rs[i] = merge(rs[i], rs[j]);
-                        rs.erase(rs.begin() + j);
+                        rs.erase(j);
                         changed = true;
                         mergeCount++;
                         goto nextOuter;
@@ -116,21 +118,20 @@ namespace {
             }
         nextOuter:;
         }
-        return rs;
     }
 
-    std::vector<Rect> dilateAndMerge(std::vector<Rect> rs, int effMargin)
+    void dilateAndMerge(RectList& rs, int effMargin)
     {
         for (auto& r : rs)
             r = dilate(r, effMargin);
-        return mergeAll(std::move(rs));
+        mergeAll(rs);
     }
 
     //-------------------------------------------
     // Étape 3 — Masque O(1) des zones actives
     //-------------------------------------------
     using ActiveMask = std::array<uint8_t, BOARD_CELLS>;
-    ActiveMask buildActiveMask(const std::vector<Rect>& rects)
+    ActiveMask buildActiveMask(const RectList& rects)
     {
         ActiveMask active {}; // zéro-initialisé
         for (const auto& r : rects)
@@ -141,14 +142,14 @@ namespace {
     }
 
     //-------------------------------------------
-    // Étape 4 — Offsets diamant (cache thread_local)
+    // Étape 4 — Offsets diamant dans le mailbox (cache thread_local)
     //-------------------------------------------
-    using Offset = std::pair<int8_t, int8_t>;
-
-    const std::vector<Offset>& diamondOffsets(int ringR)
+    // Décalages d'index dans le mailbox à bord sentinelle: rayon borné par Mailbox::PAD,
+    // les cases hors plateau lisent WALL et sont écartées sans test de bornes.
+    const std::vector<int>& diamondOffsets(int ringR)
     {
         static thread_local int cachedRingR = -1;
-        static thread_local std::vector<Offset> DIAMOND;
+        static thread_local std::vector<int> DIAMOND;
         if (cachedRingR != ringR) {
             cachedRingR = ringR;
             DIAMOND.clear();
@@ -156,7 +157,7 @@ namespace {
             for (int dy = -ringR; dy <= ringR; ++dy) {
                 int rem = ringR - std::abs(dy);
                 for (int dx = -rem; dx <= rem; ++dx)
-                    DIAMOND.emplace_back((int8_t)dx, (int8_t)dy);
+                    DIAMOND.push_back(dy * Mailbox::WIDTH + dx);
             }
         }
         return DIAMOND;
@@ -165,7 +166,16 @@ namespace {
     //-------------------------------------------
     // Déduplication (bitset compact)
     //-------------------------------------------
-    using SeenSet = std::bitset<BOARD_CELLS>;
+    // Les cases illégales (occupées, double-trois, hors cassure d'un 5 adverse) sont
+    // marquées d'emblée: complément de Board::legalMask, en opérations sur mots.
+    using SeenSet = CellSet;
+    inline SeenSet initialSeen(const Board& b, const RuleSet& rules, Player toPlay)
+    {
+        SeenSet seen = CellSet::all();
+        seen.subtract(b.legalMask(toPlay, rules));
+        return seen;
+    }
+
     inline bool markIfNew(SeenSet& seen, int x, int y)
     {
         const int i = y * BOARD_SIZE + x;
@@ -180,44 +190,43 @@ namespace {
     //-------------------------------------------
     void emitNeighborhood(const Board& b,
         const ActiveMask& active,
-        const std::vector<Offset>& ring,
+        const std::vector<int>& ring,
         uint8_t cx, uint8_t cy,
-        Player toPlay,
         uint16_t maxCandidates,
         SeenSet& seen,
-        std::vector<Move>& out)
+        MoveList& out)
     {
-        for (auto [dx, dy] : ring) {
-            int x = (int)cx + dx, y = (int)cy + dy;
-            if ((unsigned)x >= BOARD_SIZE || (unsigned)y >= BOARD_SIZE)
-                continue;
-            int idx = y * BOARD_SIZE + x;
+        const Mailbox& mail = b.mailbox();
+        const int center = Mailbox::padded(cx, cy);
+        for (int off : ring) {
+            const int q = center + off;
+            if (mail[q] != Mailbox::EMPTY)
+                continue; // occupée ou hors plateau (mur)
+            const int idx = Mailbox::boardIndex(q);
             if (!active[idx])
                 continue; // clamp O(1)
-            if (b.at((uint8_t)x, (uint8_t)y) != Cell::Empty)
-                continue;
-            if (!markIfNew(seen, x, y))
+            const Pos p = Pos::fromIndex(static_cast<uint16_t>(idx));
+            if (!markIfNew(seen, p.x, p.y))
                 continue;
-            out.push_back(Move { { (uint8_t)x, (uint8_t)y }, toPlay });
+            out.push_back(p);
             if (out.size() >= maxCandidates)
                 return;
         }
     }
 
     void generateFromRings(const Board& b,
-        const std::vector<P>& stones,
+        const std::vector<Pos>& stones,
         const ActiveMask& active,
         Player toPlay,
         const CandidateConfig& cfg,
         SeenSet& seen,
-        std::vector<Move>& out)
+        MoveList& out)
     {
-        const auto& ring = diamondOffsets(cfg.ringR);
-        out.reserve(cfg.maxCandidates);
+        const auto& ring = diamondOffsets(std::min<int>(cfg.ringR, Mailbox::PAD));
 
         if (cfg.includeOpponentRing) {
             for (const auto& p : stones) {
-                emitNeighborhood(b, active, ring, p.x, p.y, toPlay, cfg.maxCandidates, seen, out);
+                emitNeighborhood(b, active, ring, p.x, p.y, cfg.maxCandidates, seen, out);
                 if (out.size() >= cfg.maxCandidates)
                     return;
             }
@@ -226,7 +235,7 @@ namespace {
             for (const auto& p : stones) {
                 if (b.at(p.x, p.y) != mine)
                     continue;
-                emitNeighborhood(b, active, ring, p.x, p.y, toPlay, cfg.maxCandidates, seen, out);
+                emitNeighborhood(b, active, ring, p.x, p.y, cfg.maxCandidates, seen, out);
                 if (out.size() >= cfg.maxCandidates)
                     return;
             }
@@ -237,12 +246,11 @@ namespace {
     // Étape 6 — Fallback scan des rectangles
     //-------------------------------------------
     void fallbackScan(const Board& b,
-        const std::vector<Rect>& rects,
+        const RectList& rects,
         const ActiveMask& active,
-        Player toPlay,
         const CandidateConfig& cfg,
         SeenSet& seen,
-        std::vector<Move>& out)
+        MoveList& out)
     {
         for (const auto& r : rects) {
             for (int y = r.y1; y <= r.y2; ++y)
@@ -253,7 +261,7 @@ namespace {
                         continue; // cohérence
                     if (!markIfNew(seen, x, y))
                         continue;
-                    out.push_back(Move { { (uint8_t)x, (uint8_t)y }, toPlay });
+                    out.push_back(Pos { (uint8_t)x, (uint8_t)y });
                     if (out.size() >= cfg.maxCandidates)
                         return;
                 }
@@ -263,11 +271,9 @@ namespace {
     //-------------------------------------------
     // Étape 7 — Finalisation (cap + alertes)
     //-------------------------------------------
-    void finalizeCandidates(std::vector<Move>& out, uint16_t maxCandidates)
+    void finalizeCandidates(MoveList& out, uint16_t maxCandidates)
     {
-        if (out.size() > maxCandidates) {
-            out.resize(maxCandidates);
-        }
+        out.truncate(maxCandidates);
     }
 
     //-------------------------------------------
@@ -286,40 +292,46 @@ namespace {
 std::vector<Move> CandidateGenerator::generate(const Board& b, const RuleSet& rules,
     Player toPlay, const CandidateConfig& cfg)
 {
-    (void)rules; // légalité fine = moteur play/undo
+    MoveList out;
+    generate(b, rules, toPlay, cfg, out);
+    return out.toMoves(toPlay);
+}
+
+void CandidateGenerator::generate(const Board& b, const RuleSet& rules,
+    Player toPlay, const CandidateConfig& cfg, MoveList& out)
+{
+    out.clear();
 
     // 0) Plateau vide -> centre
     if (isEmptyBoard(b)) {
         LOG_INFO("Empty board detected - center move");
-        Move c { { (uint8_t)(BOARD_SIZE / 2), (uint8_t)(BOARD_SIZE / 2) }, toPlay };
-        return { c };
+        out.push_back(Pos { (uint8_t)(BOARD_SIZE / 2), (uint8_t)(BOARD_SIZE / 2) });
+        return;
     }
 
-    // 1) Collecte des pierres
-    std::vector<P> stones;
-    collectStones(b, stones);
+    // 1) Pierres: index creux du plateau (aucune copie)
+    const std::vector<Pos>& stones = b.occupiedPositions();
 
     // 2) Îlots (BFS Chebyshev) -> dilatation(>=ringR) -> fusion
-    auto rects = buildIslands(stones, cfg.groupGap);
+    RectList rects;
+    buildIslands(stones, cfg.groupGap, rects);
     const int effMargin = std::max<int>(cfg.margin, cfg.ringR);
-    rects = dilateAndMerge(std::move(rects), effMargin);
+    dilateAndMerge(rects, effMargin);
 
     // 3) Masque des zones actives
     ActiveMask active = buildActiveMask(rects);
 
-    // 4–5) Anneaux (Manhattan <= ringR) clampés par masque + dédup bitset
-    SeenSet seen;
-    std::vector<Move> out;
+    // 4–5) Anneaux (Manhattan <= ringR) clampés par masque + dédup bitset (illégales pré-marquées)
+    SeenSet seen = initialSeen(b, rules, toPlay);
     generateFromRings(b, stones, active, toPlay, cfg, seen, out);
 
     // 6) Fallback scan si densité insuffisante
     if (out.size() < 12) {
-        fallbackScan(b, rects, active, toPlay, cfg, seen, out);
+        fallbackScan(b, rects, active, cfg, seen, out);
     }
 
     // 7) Finalisation
     finalizeCandidates(out, cfg.maxCandidates);
-    return out;
 }
 
 } // namespace gomoku
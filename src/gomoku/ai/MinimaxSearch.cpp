@@ -4,15 +4,18 @@
 #include "gomoku/core/Board.hpp"
 #include "gomoku/core/Logger.hpp"
 #include <algorithm>
+#include <bit>
 #include <functional>
 #include <limits>
+#include <thread>
+#include <utility>
 
 namespace gomoku {
 
 namespace {
     using Clock = std::chrono::steady_clock;
 
-    inline void setStats(SearchStats* stats, Clock::time_point start, long long nodes, long long qnodes, int depth, int ttHits, const std::vector<Move>& pv)
+    inline void setStats(SearchStats* stats, Clock::time_point start, long long nodes, long long qnodes, int depth, int ttHits, const std::vector<Move>& pv, int ttProbes = 0, int ttCollisions = 0)
     {
         if (!stats)
             return;
@@ -21,27 +24,115 @@ namespace {
         stats->depthReached = depth;
         stats->timeMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
         stats->ttHits = ttHits;
+        stats->ttProbes = ttProbes;
+        stats->ttCollisions = ttCollisions;
         stats->principalVariation = pv;
+        stats->threatNodes = 0;
     }
 
     // Generate root candidates with fallback to legal moves
-    inline std::vector<Move> genRootCandidates(const Board& board, const RuleSet& rules, Player toPlay)
+    inline void genRootCandidates(const Board& board, const RuleSet& rules, Player toPlay, MoveList& out)
     {
-        auto cands = CandidateGenerator::generate(board, rules, toPlay, CandidateConfig {});
-        if (cands.empty())
-            cands = board.legalMoves(toPlay, rules);
-        return cands;
+        CandidateGenerator::generate(board, rules, toPlay, CandidateConfig {}, out);
+        if (out.empty())
+            board.legalMoves(toPlay, rules, out);
+    }
+
+    // Moves m to index 'to' (default: the front), the moves in between keeping their order;
+    // false if m is not in the list at or after 'to'
+    inline bool promote(MoveList& moves, PackedMove m, int to = 0)
+    {
+        for (int i = to; i < moves.size(); ++i) {
+            if (moves[i] == m) {
+                std::rotate(moves.begin() + to, moves.begin() + i, moves.begin() + i + 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Tri stable (insertion) de moves[from..] par historique décroissant; pas d'allocation
+    inline void sortByHistory(MoveList& moves, int from, const std::array<int, BOARD_SIZE * BOARD_SIZE>& history)
+    {
+        for (int i = from + 1; i < moves.size(); ++i) {
+            const PackedMove m = moves[i];
+            const int h = history[m.index()];
+            int j = i;
+            for (; j > from && history[moves[j - 1].index()] < h; --j)
+                moves[j] = moves[j - 1];
+            moves[j] = m;
+        }
     }
 
 } // namespace
 
+MinimaxSearch::MinimaxSearch(const SearchConfig& conf)
+    : cfg(conf)
+{
+    tt.resizeBytes(cfg.ttBytes);
+    ensureWorkers();
+}
+
+MinimaxSearch::~MinimaxSearch() = default;
+
+void MinimaxSearch::Worker::resetForSearch()
+{
+    nodes = 0;
+    aborted = false;
+    followPv = false;
+    prevPvLength = 0;
+    ttProbes = ttHits = ttCollisions = 0;
+    threatNodes = 0;
+    split = nullptr;
+    dequeSize = 0;
+    for (auto& k : killers)
+        k.fill(PackedMove::none());
+    for (auto& h : history)
+        h.fill(0);
+}
+
+// Un worker par thread; les aides ont leur propre plateau, recopié de la racine à chaque recherche
+void MinimaxSearch::ensureWorkers()
+{
+    const auto count = static_cast<std::size_t>(std::max(1, cfg.threads));
+    while (workers.size() < count) {
+        auto w = std::make_unique<Worker>();
+        w->id = static_cast<int>(workers.size());
+        if (w->id > 0) {
+            w->ownBoard = std::make_unique<Board>();
+            w->board = w->ownBoard.get();
+        }
+        workers.push_back(std::move(w));
+    }
+    workers.resize(count);
+}
+
+void MinimaxSearch::clearTranspositionTable()
+{
+    tt.clear();
+    for (auto& w : workers)
+        w->solver.clearCache();
+}
+
 // Note: cellOf and other are now available as playerToCell and opponent in Types.hpp
 std::optional<Move> MinimaxSearch::bestMove(Board& board, const RuleSet& rules, SearchStats* stats)
+{
+    // Variante de règles choisie une fois: toute la recherche suit le moteur spécialisé
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() { return search<V>(board, rules, stats); });
+}
+
+template <RuleVariant V>
+std::optional<Move> MinimaxSearch::search(Board& board, const RuleSet& rules, SearchStats* stats)
 {
     using namespace std::chrono;
     auto start = steady_clock::now();
     auto deadline = start + milliseconds(cfg.timeBudgetMs);
-    SearchContext ctx { rules, deadline, stats, cfg.nodeCap };
+    std::atomic<bool> stop { false };
+    std::atomic<unsigned long long> sharedNodes { 0 };
+    std::atomic<int> idleThreads { 0 };
+    std::atomic<int> splits { 0 };
+    std::atomic<uint32_t> workSignal { 0 };
+    SearchContext ctx { rules, deadline, stats, cfg.nodeCap, stop, sharedNodes, idleThreads, splits, workSignal };
 
     Player toPlay = board.toPlay();
     // Early terminal check
@@ -51,7 +142,15 @@ std::optional<Move> MinimaxSearch::bestMove(Board& board, const RuleSet& rules,
         return std::nullopt;
     }
 
-    std::vector<Move> candidates = genRootCandidates(board, rules, toPlay);
+    ensureWorkers();
+    for (auto& w : workers)
+        w->resetForSearch();
+    Worker& main = *workers[0];
+    main.board = &board;
+    tt.newSearch();
+
+    MoveList candidates;
+    genRootCandidates(board, rules, toPlay, candidates);
 
     if (candidates.empty()) {
         setStats(stats, start, 0, 0, 0, 0, {});
@@ -59,70 +158,260 @@ std::optional<Move> MinimaxSearch::bestMove(Board& board, const RuleSet& rules,
     }
 
     // 1) Immediate win shortcut (only if situation permits)
-    if (auto iw = tryImmediateWinShortcut(board, rules, toPlay, candidates)) {
+    if (auto iw = tryImmediateWinShortcut<V>(board, rules, toPlay, candidates)) {
         setStats(stats, start, /*nodes*/ 1, /*qnodes*/ 0, /*depth*/ 1, /*ttHits*/ 0, { *iw });
         return iw;
     }
 
-    // 2) Iterative deepening skeleton using the compact helper
+    // 2) Gain forcé par menaces (VCF, puis VCT) prouvé avant la recherche principale
+    if (cfg.threatSolver) {
+        int plies = 0;
+        if (auto tw = rootThreatWin(main, rules, plies)) {
+            setStats(stats, start, 0, 0, plies, 0, { *tw });
+            if (stats)
+                stats->threatNodes = main.threatNodes;
+            return tw;
+        }
+    }
+
+    // 3) Threads d'aide, chacun sur sa copie du plateau; seul le résultat du thread principal
+    //    est retenu. Lazy SMP: ils cherchent la même racine et n'échangent que par la TT.
+    //    YBWC: ils volent les frères cadets des nœuds partagés par les autres threads.
+    std::vector<std::thread> helpers;
+    if (workers.size() > 1) {
+        helpers.reserve(workers.size() - 1);
+        for (std::size_t i = 1; i < workers.size(); ++i) {
+            Worker& h = *workers[i];
+            *h.board = board;
+            helpers.emplace_back([this, &h, &candidates, &ctx] {
+                if (cfg.parallel == ParallelMode::Ybwc)
+                    ybwcHelper<V>(h, ctx);
+                else
+                    helperSearch<V>(h, candidates, ctx);
+            });
+        }
+    }
+
+    // 4) Iterative deepening skeleton using the compact helper
     std::optional<Move> best;
     std::vector<Move> pv;
+    pv.reserve(PvTable::MAX_PLY);
     long long nodes = 0;
-    int ttHits = 0;
     int maxDepth = cfg.maxDepthHint;
     int bestScore = -INF;
+    int depthReached = 0;
 
     for (int depth = 1; depth <= maxDepth; ++depth) {
-        if (!runDepth(depth, board, rules, toPlay, candidates, best, bestScore, pv, nodes, ctx))
+        if (!runDepth<V>(main, depth, rules, toPlay, candidates, best, bestScore, pv, nodes, ctx))
             break;
-        setStats(stats, start, nodes, /*qnodes*/ 0, /*depth*/ depth, ttHits, pv);
+        depthReached = depth;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    signalWork(ctx);
+    for (auto& t : helpers)
+        t.join();
+
+    if (!best) {
+        setStats(stats, start, 0, 0, 0, 0, {});
+        return std::nullopt;
     }
 
-    if (best) {
-        return best;
+    long long total = 0, threatNodes = 0;
+    int hits = 0, probes = 0, collisions = 0;
+    for (const auto& w : workers) {
+        total += static_cast<long long>(w->nodes);
+        threatNodes += w->threatNodes;
+        hits += w->ttHits;
+        probes += w->ttProbes;
+        collisions += w->ttCollisions;
     }
+    setStats(stats, start, total, /*qnodes*/ 0, depthReached, hits, pv, probes, collisions);
+    if (stats) {
+        stats->splits = splits.load(std::memory_order_relaxed);
+        stats->threatNodes = threatNodes;
+        stats->threadNodes.resize(workers.size());
+        for (std::size_t i = 0; i < workers.size(); ++i)
+            stats->threadNodes[i] = static_cast<long long>(workers[i]->nodes);
+    }
+    return best;
+}
 
-    setStats(stats, start, 0, 0, 0, 0, {});
+// Thread d'aide Lazy SMP: approfondissement itératif sur son plateau jusqu'à l'arrêt
+// demandé par le thread principal. Les aides impaires commencent un cran plus profond
+// pour que les threads ne parcourent pas le même arbre au même moment.
+template <RuleVariant V>
+void MinimaxSearch::helperSearch(Worker& w, const MoveList& rootCandidates, const SearchContext& ctx)
+{
+    const Player toPlay = w.board->toPlay();
+    std::optional<Move> best;
+    std::vector<Move> pv;
+    pv.reserve(PvTable::MAX_PLY);
+    long long nodes = 0;
+    int bestScore = -INF;
+    for (int depth = 1 + (w.id & 1); depth <= cfg.maxDepthHint; ++depth)
+        if (!runDepth<V>(w, depth, ctx.rules, toPlay, rootCandidates, best, bestScore, pv, nodes, ctx))
+            break;
+}
+
+// Solveur de menaces à la racine: VCF d'abord (moins cher, plus long), puis VCT.
+// Chaque recherche a son propre budget de nœuds; le cache du solveur survit aux coups.
+std::optional<Move> MinimaxSearch::rootThreatWin(Worker& w, const RuleSet& rules, int& plies)
+{
+    Board& board = *w.board;
+    const std::pair<ThreatSolver::Mode, int> passes[] = { { ThreatSolver::Mode::Vcf, ROOT_VCF_ATTACKS },
+        { ThreatSolver::Mode::Vct, ROOT_VCT_ATTACKS } };
+    for (const auto& [mode, attacks] : passes) {
+        const auto r = w.solver.solve(board, rules, mode, attacks, ROOT_SOLVER_NODES);
+        w.threatNodes += r.nodes;
+        if (r.move) {
+            plies = r.plies;
+            return r.move;
+        }
+    }
     return std::nullopt;
 }
 
 std::vector<Move> MinimaxSearch::orderedMovesPublic(const Board& board, const RuleSet& rules, Player toPlay) const
 {
-    auto moves = CandidateGenerator::generate(board, rules, toPlay, CandidateConfig {});
-    if (moves.empty()) {
-        moves = board.legalMoves(toPlay, rules);
-    }
-    return moves;
+    MoveList moves;
+    withRuleVariant(rules.variant(), [&]<RuleVariant V>() { orderMoves<V>(board, rules, toPlay, PackedMove::none(), moves); });
+    return moves.toMoves(toPlay);
 }
 
-// --- Stubs for private methods declared in MinimaxSearch.hpp ---
+// --- Private search primitives declared in MinimaxSearch.hpp ---
 
-// Négamax récursif (Gomoku) avec extensions possibles plus tard (alpha-bêta/PVS/TT).
+// Négamax alpha-bêta en PVS (Gomoku), fail-soft.
 // Rôle:
 //  - Arrêt immédiat si état terminal (cinq alignés, victoire par captures, nul).
-//  - En feuille (profondeur 0): renvoyer evaluate(...).
-//  - Sinon: ordonner les coups via orderMoves(...) en privilégiant les menaces Gomoku
-//    (gains en 1, parades de menaces adverses, créations de quatre ouverts, captures de paires critiques),
-//    puis explorer récursivement (tryPlay → negamax → undo), construire la PV.
-// TODO (palier 3): implémentation depth-limitée simple (sans alpha-bêta), puis ajouter alpha-bêta/PVS.
-int MinimaxSearch::negamax(Board& board,
+//  - En feuille (profondeur 0): renvoyer evaluate(...) au trait.
+//  - Table de transposition: coupure sur une borne suffisante aux nœuds en fenêtre nulle,
+//    son coup sinon essayé en premier; résultat stocké en fin de nœud.
+//  - Assez de profondeur restante: un gain par quatre successifs (VCF) prouvé par le solveur
+//    de menaces rend le score de mat sans recherche pleine largeur.
+//  - Sinon: ordonner les coups via orderMoves(...) puis killers et historique du thread
+//    (coup de la PV précédente en tête), explorer le premier en fenêtre pleine, les suivants en fenêtre nulle et ne
+//    relancer en fenêtre pleine que ceux qui la dépassent (doMove → negamax → undoMove).
+//  - Meilleure ligne dans la ligne 'ply' de w.pvTable; listes de coups dans l'arène de w.
+// Sur dépassement du temps/nodeCap ou arrêt commun, w.aborted est levé et le score renvoyé n'a plus de sens.
+// TODO (plus tard): extensions sur menaces (quatre ouvert, capture gagnante), LMR ciblé.
+template <RuleVariant V>
+int MinimaxSearch::negamax(Worker& w,
     int depth,
     int alpha,
     int beta,
     int ply,
-    std::vector<Move>& pvOut,
     const SearchContext& ctx)
 {
-    // TODO: Terminal check, éval en feuille, génération + boucle enfants (tryPlay/undo), build PV.
-    // TODO (plus tard): alpha-bêta/PVS, TT probe/store, extensions sur menaces (quatre ouvert, capture gagnante), LMR ciblé.
-    (void)board;
-    (void)depth;
-    (void)alpha;
-    (void)beta;
-    (void)ply;
-    (void)ctx;
-    pvOut.clear();
-    return 0;
+    Board& board = *w.board;
+    w.pvTable.clear(ply);
+    if (shouldAbort(w, ctx))
+        return 0;
+
+    int terminalScore = 0;
+    if (isTerminal(board, ply, terminalScore))
+        return terminalScore;
+    const Player toMove = board.toPlay();
+    if (depth <= 0 || ply >= PvTable::MAX_PLY - 1)
+        return evaluate(board, toMove);
+
+    // Les nœuds PV (fenêtre ouverte) ne coupent pas sur la TT: leur ligne reste complète
+    PackedMove ttMove = PackedMove::none();
+    int ttScore = 0;
+    if (ttProbe(w, depth, alpha, beta, ply, ttScore, ttMove) && beta - alpha == 1)
+        return ttScore;
+
+    if (cfg.threatSolver && depth >= VCF_MIN_DEPTH && ThreatSolver::canStartVcf(board, ctx.rules)) {
+        const auto r = w.solver.solve(board, ctx.rules, ThreatSolver::Mode::Vcf, NODE_VCF_ATTACKS, NODE_SOLVER_NODES);
+        w.threatNodes += r.nodes;
+        if (r.move) {
+            // Borne basse: un gain plus court peut exister hors des menaces
+            const int score = MATE_SCORE - (ply + r.plies);
+            const PackedMove win(*r.move);
+            w.pvTable.clear(ply + 1);
+            w.pvTable.update(ply, win);
+            ttStore(w, depth, ply, score, TranspositionTable::Flag::Lower, win);
+            return score;
+        }
+    }
+
+    SearchArena::Scope scope(w.arena);
+    MoveList* list = w.arena.allocate<MoveList>();
+    if (!list)
+        return evaluate(board, toMove); // arène pleine: la branche s'arrête ici
+    MoveList& moves = *list;
+    orderMoves<V>(board, ctx.rules, toMove, ttMove, moves);
+    // Coups meurtriers de ce ply juste après le coup de la TT, captures ensuite, puis les
+    // coups calmes par historique; enfin (tant qu'on la suit) le coup de la PV précédente en tête
+    const int head = (!ttMove.isNone() && !moves.empty() && moves[0] == ttMove) ? 1 : 0;
+    int quietFrom = head;
+    for (int k = KILLERS - 1; k >= 0; --k)
+        if (!w.killers[ply][k].isNone() && promote(moves, w.killers[ply][k], head))
+            ++quietFrom;
+    const bool captures = V.captures && board.captureMask(toMove).any();
+    const int color = toMove == Player::Black ? 0 : 1;
+    while (captures && quietFrom < moves.size() && board.captureMask(toMove).test(moves[quietFrom].index()))
+        ++quietFrom;
+    sortByHistory(moves, quietFrom, w.history[color]);
+    if (w.followPv)
+        w.followPv = ply < w.prevPvLength && promote(moves, w.prevPv[ply]);
+
+    const int alphaOrig = alpha;
+    int best = -INF;
+    PackedMove bestMove = PackedMove::none();
+    bool first = true;
+    for (int i = 0; i < moves.size(); ++i) {
+        const PackedMove pm = moves[i];
+        const Move m = pm.toMove(toMove);
+        tt.prefetch(board.keyAfter(m)); // chargé pendant que doMove travaille
+        w.path[ply] = pm;
+        board.doMoveFor<V>(m, ctx.rules);
+        int score;
+        if (first) {
+            score = -negamax<V>(w, depth - 1, -beta, -alpha, ply + 1, ctx);
+        } else {
+            score = -negamax<V>(w, depth - 1, -alpha - 1, -alpha, ply + 1, ctx);
+            if (score > alpha && score < beta && !w.aborted)
+                score = -negamax<V>(w, depth - 1, -beta, -alpha, ply + 1, ctx);
+        }
+        board.undoMove();
+        if (w.aborted)
+            return 0;
+        first = false;
+
+        if (score > best) {
+            best = score;
+            bestMove = pm;
+            if (score > alpha) {
+                alpha = score;
+                w.pvTable.update(ply, pm); // coup + ligne de l'enfant (ligne ply + 1)
+            }
+        }
+        // YBWC: l'aîné est cherché, les frères restants sont partagés avec les threads libres
+        const bool shared = alpha < beta && canSplit(w, depth, moves.size() - i - 1, ctx);
+        if (shared) {
+            splitNode<V>(w, moves, i + 1, depth, alpha, beta, ply, best, bestMove, ctx);
+            if (w.aborted)
+                return 0;
+        }
+        if (alpha >= beta) {
+            w.storeKiller(ply, bestMove);
+            if (!captures || !board.captureMask(toMove).test(bestMove.index()))
+                w.history[color][bestMove.index()] += depth * depth;
+            break;
+        }
+        if (shared)
+            break;
+    }
+    // Aucun coup (ne devrait pas arriver en partie en cours): position jugée statiquement
+    if (first)
+        return evaluate(board, toMove);
+
+    const auto flag = best >= beta ? TranspositionTable::Flag::Lower
+        : best > alphaOrig         ? TranspositionTable::Flag::Exact
+                                   : TranspositionTable::Flag::Upper;
+    ttStore(w, depth, ply, best, flag, bestMove);
+    return best;
 }
 
 // Recherche de quiétude (Gomoku):
@@ -133,6 +422,7 @@ int MinimaxSearch::negamax(Board& board,
 //    • éventuellement prolongations locales de menaces fortes.
 //  - Évite d’explorer des coups calmes qui n’affectent pas les menaces en cours.
 // TODO: stand-pat (éval statique), delta pruning adapté aux marges de menaces, génération coups tactiques.
+template <RuleVariant V>
 int MinimaxSearch::qsearch(Board& board,
     int alpha,
     int beta,
@@ -196,15 +486,16 @@ int MinimaxSearch::evaluate(const Board& board, Player perspective) const
         constexpr int FRONT_WEIGHT = 5; // final multiplier
         // Weights for last moves: most recent gets highest weight
         constexpr int W1 = 3, W2 = 2, W3 = 1; // sum = 6
-        const auto recents = board.lastMoves(3);
+        MoveList recents;
+        board.lastMoves(3, recents);
         if (!recents.empty()) {
             int frontAccum = 0;
             int weightSum = 0;
-            for (std::size_t i = 0; i < recents.size(); ++i) {
+            for (int i = 0; i < recents.size(); ++i) {
                 const int wMove = (i == 0 ? W1 : (i == 1 ? W2 : W3));
                 weightSum += wMove;
-                const int lx = recents[i].pos.x;
-                const int ly = recents[i].pos.y;
+                const int lx = recents[i].pos().x;
+                const int ly = recents[i].pos().y;
                 int frontLocal = 0;
                 for (const auto& p : occ) {
                     const int x = p.x, y = p.y;
@@ -242,49 +533,15 @@ int MinimaxSearch::evaluate(const Board& board, Player perspective) const
         }
     };
 
-    constexpr int DIRS[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
-    int patternScore = 0;
-    for (const auto& p : occ) {
-        const int x = p.x, y = p.y;
-        const Cell c = board.at(static_cast<uint8_t>(x), static_cast<uint8_t>(y));
-        for (const auto& d : DIRS) {
-            const int dx = d[0], dy = d[1];
-            const int prevX = x - dx, prevY = y - dy;
-            // Only start at the beginning of a run for this direction
-            if (prevX >= 0 && prevX < BOARD_SIZE && prevY >= 0 && prevY < BOARD_SIZE) {
-                if (board.at(static_cast<uint8_t>(prevX), static_cast<uint8_t>(prevY)) == c)
-                    continue;
-            }
-            // Count run length
-            int len = 0;
-            int nx = x, ny = y;
-            while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board.at(static_cast<uint8_t>(nx), static_cast<uint8_t>(ny)) == c) {
-                ++len;
-                nx += dx;
-                ny += dy;
-            }
-            // Determine openness at both ends
-            int openEnds = 0;
-            if (prevX >= 0 && prevX < BOARD_SIZE && prevY >= 0 && prevY < BOARD_SIZE) {
-                if (board.at(static_cast<uint8_t>(prevX), static_cast<uint8_t>(prevY)) == Cell::Empty)
-                    ++openEnds;
-            } else {
-                // Off-board is closed
-            }
-            if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-                if (board.at(static_cast<uint8_t>(nx), static_cast<uint8_t>(ny)) == Cell::Empty)
-                    ++openEnds;
-            } else {
-                // Off-board is closed
-            }
-
-            const int val = runValue(len, openEnds);
-            if (c == me)
-                patternScore += val;
-            else if (c == opp)
-                patternScore -= val;
-        }
-    }
+    // One vectorized pass over all line words per color (run lengths + open ends)
+    auto runsScore = [&](const RunCounts& rc) {
+        int sum = rc.fives * runValue(5, 0);
+        for (int len = 1; len <= 4; ++len)
+            for (int open = 0; open <= 2; ++open)
+                sum += rc.runs[len - 1][open] * runValue(len, open);
+        return sum;
+    };
+    const int patternScore = runsScore(board.runCounts(perspective)) - runsScore(board.runCounts(opponent(perspective)));
     score += patternScore;
 
     return score;
@@ -297,25 +554,258 @@ int MinimaxSearch::evaluate(const Board& board, Player perspective) const
 //  - 4) Captures de paires critiques,
 //  - 5) Extensions de menaces (étendre 3→4, 4→5) près du front,
 //  - 6) Heuristique géométrique (proximité des pierres existantes), killers/history en option.
-// TODO: placer ttMove en tête si dispo, puis classer par criticité des menaces/captures; plafonner à N coups pour maitriser le branching.
-std::vector<Move> MinimaxSearch::orderMoves(const Board& board,
+// TODO: classer par criticité des menaces; plafonner à N coups pour maitriser le branching.
+template <RuleVariant V>
+void MinimaxSearch::orderMoves(const Board& board,
     const RuleSet& rules,
     Player toMove,
-    const std::optional<Move>& ttMove) const
+    PackedMove ttMove,
+    MoveList& out) const
 {
-    // TODO: Placer ttMove en tête, réordonner par menaces/captures Gomoku, limiter à un top-N.
-    (void)ttMove;
-    return orderedMovesPublic(board, rules, toMove);
+    // TODO: Réordonner par menaces Gomoku, limiter à un top-N.
+    CandidateGenerator::generate(board, rules, toMove, CandidateConfig {}, out);
+    if (out.empty())
+        board.legalMoves(toMove, rules, out);
+
+    // Captures d'abord: simple lecture de l'index de menaces du Board, ordre stable sinon
+    // (partition à la main: std::stable_partition peut allouer un tampon)
+    if (V.captures && board.captureMask(toMove).any()) {
+        const auto& captures = board.captureMask(toMove);
+        MoveList quiet;
+        int n = 0;
+        for (const PackedMove m : out) {
+            if (captures.test(m.index()))
+                out[n++] = m;
+            else
+                quiet.push_back(m);
+        }
+        for (const PackedMove m : quiet)
+            out[n++] = m;
+    }
+
+    // Coup de la TT en tête, s'il fait partie des coups générés (donc légal ici)
+    if (!ttMove.isNone())
+        promote(out, ttMove);
 }
 
 // Renvoie true si le temps est écoulé ou nodeCap atteint (soft stop).
-// Note: nodeCap doit être incrémenté côté recherche (negamax/qsearch) pour être effectif.
-bool MinimaxSearch::cutoffByTime(const SearchContext& ctx) const
+// Les nœuds comptés sont ceux versés par tous les threads plus ceux, pas encore versés, de l'appelant.
+bool MinimaxSearch::cutoffByTime(const SearchContext& ctx, unsigned long long pendingNodes) const
 {
-    // TODO: Ajouter nodeCap check si besoin.
+    if (ctx.nodeCap && ctx.sharedNodes.load(std::memory_order_relaxed) + pendingNodes >= ctx.nodeCap)
+        return true;
     return std::chrono::steady_clock::now() >= ctx.deadline;
 }
 
+// Compte le nœud et dit s'il faut s'arrêter. Les compteurs sont versés au total partagé
+// par paquets de 1024 (l'horloge n'est lue qu'à ce moment, sauf avec nodeCap); le premier
+// thread qui atteint une limite lève le drapeau d'arrêt commun.
+bool MinimaxSearch::shouldAbort(Worker& w, const SearchContext& ctx) const
+{
+    ++w.nodes;
+    if (w.aborted)
+        return true;
+    bool limit = false;
+    if ((w.nodes & 1023) == 0) {
+        ctx.sharedNodes.fetch_add(1024, std::memory_order_relaxed);
+        limit = cutoffByTime(ctx);
+    } else if (ctx.nodeCap) {
+        limit = cutoffByTime(ctx, w.nodes & 1023);
+    }
+    if (limit)
+        ctx.stop.store(true, std::memory_order_relaxed);
+    w.aborted = ctx.stop.load(std::memory_order_relaxed) || cutOff(w.split);
+    return w.aborted;
+}
+
+bool MinimaxSearch::cutOff(const SplitPoint* sp)
+{
+    for (; sp; sp = sp->parent)
+        if (sp->cutoff.load(std::memory_order_relaxed))
+            return true;
+    return false;
+}
+
+// Partage utile seulement s'il reste du travail (assez de profondeur, au moins deux frères)
+// et un thread libre pour le prendre
+bool MinimaxSearch::canSplit(const Worker& w, int depth, int movesLeft, const SearchContext& ctx) const
+{
+    return cfg.parallel == ParallelMode::Ybwc && workers.size() > 1 && depth >= SPLIT_MIN_DEPTH && movesLeft >= 2
+        && !w.aborted && ctx.idleThreads.load(std::memory_order_relaxed) > 0;
+}
+
+// Vol de travail: on parcourt les piles des autres threads, la plus ancienne entrée d'abord
+// (la plus proche de la racine, donc le plus gros sous-arbre). Le point est marqué actif
+// sous le verrou de son propriétaire, qui ne peut donc plus le libérer avant notre départ.
+// Avec 'under', seuls les points imbriqués dans celui-ci (ouverts sous lui par ses aides).
+MinimaxSearch::SplitPoint* MinimaxSearch::stealSplit(Worker& thief, const SplitPoint* under)
+{
+    const int count = static_cast<int>(workers.size());
+    for (int k = 1; k < count; ++k) {
+        Worker& victim = *workers[static_cast<std::size_t>((thief.id + k) % count)];
+        std::lock_guard<std::mutex> guard(victim.dequeLock);
+        for (int i = 0; i < victim.dequeSize; ++i) {
+            SplitPoint* sp = victim.deque[i];
+            const SplitPoint* up = sp->parent;
+            while (under && up && up != under)
+                up = up->parent;
+            if (under && !up)
+                continue;
+            if (!sp->cutoff.load(std::memory_order_relaxed) && sp->next.load(std::memory_order_relaxed) < sp->moves->size()) {
+                sp->active.fetch_add(1, std::memory_order_relaxed);
+                return sp;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void MinimaxSearch::signalWork(const SearchContext& ctx)
+{
+    ctx.workSignal.fetch_add(1, std::memory_order_release);
+    ctx.workSignal.notify_all();
+}
+
+// Ouvre un point de partage sur le nœud (ligne 'ply' de w.splits) et y prend des coups
+// jusqu'à épuisement, puis le retire de la pile. Tant que des voleurs y travaillent, le
+// propriétaire aide aux partages qu'ils ont ouverts dessous, sinon il attend le signal.
+template <RuleVariant V>
+void MinimaxSearch::splitNode(Worker& w, const MoveList& moves, int from, int depth, int& alpha, int beta, int ply,
+    int& best, PackedMove& bestMove, const SearchContext& ctx)
+{
+    SplitPoint& sp = w.splits[ply];
+    sp.moves = &moves;
+    sp.next.store(from, std::memory_order_relaxed);
+    sp.alpha.store(alpha, std::memory_order_relaxed);
+    sp.active.store(0, std::memory_order_relaxed);
+    sp.cutoff.store(false, std::memory_order_relaxed);
+    sp.beta = beta;
+    sp.depth = depth;
+    sp.ply = ply;
+    sp.best = best;
+    sp.bestMove = bestMove;
+    for (int i = 0; i < ply; ++i)
+        sp.path[i] = w.path[i];
+    sp.owner = &w;
+    sp.parent = w.split;
+    ctx.splits.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> guard(w.dequeLock);
+        w.deque[w.dequeSize++] = &sp;
+    }
+    signalWork(ctx);
+
+    w.split = &sp;
+    searchSplit<V>(w, sp, ctx);
+    {
+        std::lock_guard<std::mutex> guard(w.dequeLock);
+        --w.dequeSize; // les partages imbriqués sont déjà retirés: sp est au sommet
+    }
+    ctx.idleThreads.fetch_add(1, std::memory_order_relaxed); // ses voleurs peuvent partager pour lui
+    for (;;) {
+        const uint32_t seen = ctx.workSignal.load(std::memory_order_acquire);
+        if (sp.active.load(std::memory_order_acquire) == 0)
+            break;
+        SplitPoint* nested = w.aborted ? nullptr : stealSplit(w, &sp);
+        if (!nested) {
+            ctx.workSignal.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        ctx.idleThreads.fetch_sub(1, std::memory_order_relaxed);
+        joinSplit<V>(w, *nested, ply, ctx);
+        ctx.idleThreads.fetch_add(1, std::memory_order_relaxed);
+        w.split = &sp;
+        w.aborted = ctx.stop.load(std::memory_order_relaxed) || cutOff(&sp);
+    }
+    ctx.idleThreads.fetch_sub(1, std::memory_order_relaxed);
+    w.split = sp.parent;
+    w.aborted = ctx.stop.load(std::memory_order_relaxed) || cutOff(w.split);
+
+    best = sp.best;
+    bestMove = sp.bestMove;
+    alpha = sp.alpha.load(std::memory_order_relaxed);
+}
+
+// Boucle commune au propriétaire et aux voleurs: un coup à la fois, fenêtre nulle sur
+// l'alpha partagé puis relance si elle est dépassée; résultats fusionnés sous verrou.
+template <RuleVariant V>
+void MinimaxSearch::searchSplit(Worker& w, SplitPoint& sp, const SearchContext& ctx)
+{
+    Board& board = *w.board;
+    const Player toMove = board.toPlay();
+    const MoveList& moves = *sp.moves;
+    for (int i = sp.next.fetch_add(1, std::memory_order_relaxed); i < moves.size(); i = sp.next.fetch_add(1, std::memory_order_relaxed)) {
+        if (w.aborted || sp.cutoff.load(std::memory_order_relaxed))
+            break;
+        const PackedMove pm = moves[i];
+        const int alpha = sp.alpha.load(std::memory_order_relaxed);
+        w.path[sp.ply] = pm;
+        board.doMoveFor<V>(pm.toMove(toMove), ctx.rules);
+        int score = -negamax<V>(w, sp.depth - 1, -alpha - 1, -alpha, sp.ply + 1, ctx);
+        if (score > alpha && score < sp.beta && !w.aborted)
+            score = -negamax<V>(w, sp.depth - 1, -sp.beta, -alpha, sp.ply + 1, ctx);
+        board.undoMove();
+        if (w.aborted)
+            break;
+
+        std::lock_guard<std::mutex> guard(sp.lock);
+        if (score > sp.best) {
+            sp.best = score;
+            sp.bestMove = pm;
+            if (score > sp.alpha.load(std::memory_order_relaxed)) {
+                sp.alpha.store(score, std::memory_order_relaxed);
+                sp.owner->pvTable.update(sp.ply, pm, w.pvTable);
+                if (score >= sp.beta)
+                    sp.cutoff.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+// Thread d'aide YBWC: vole un point de partage, rejoue sur son plateau le chemin depuis la
+// racine, y prend des coups puis revient à la racine, jusqu'à l'arrêt de la recherche.
+template <RuleVariant V>
+void MinimaxSearch::ybwcHelper(Worker& w, const SearchContext& ctx)
+{
+    ctx.idleThreads.fetch_add(1, std::memory_order_relaxed);
+    for (;;) {
+        const uint32_t seen = ctx.workSignal.load(std::memory_order_acquire);
+        if (ctx.stop.load(std::memory_order_relaxed))
+            break;
+        SplitPoint* sp = stealSplit(w);
+        if (!sp) {
+            ctx.workSignal.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        ctx.idleThreads.fetch_sub(1, std::memory_order_relaxed);
+        joinSplit<V>(w, *sp, 0, ctx);
+        w.split = nullptr;
+        w.aborted = false;
+        ctx.idleThreads.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Rejoue le chemin du point volé depuis la ligne 'from', y prend des coups, revient puis
+// le quitte; le signal réveille son propriétaire s'il attendait ce départ.
+template <RuleVariant V>
+void MinimaxSearch::joinSplit(Worker& w, SplitPoint& sp, int from, const SearchContext& ctx)
+{
+    Board& board = *w.board;
+    Player side = board.toPlay();
+    for (int i = from; i < sp.ply; ++i) {
+        w.path[i] = sp.path[i];
+        board.doMoveFor<V>(sp.path[i].toMove(side), ctx.rules);
+        side = opponent(side);
+    }
+    w.split = &sp;
+    w.aborted = ctx.stop.load(std::memory_order_relaxed) || cutOff(&sp);
+    searchSplit<V>(w, sp, ctx);
+    for (int i = from; i < sp.ply; ++i)
+        board.undoMove();
+    sp.active.fetch_sub(1, std::memory_order_release);
+    signalWork(ctx);
+}
+
 // Détecte si la position est terminale (Gomoku): victoire (5 alignés ou par captures) ou nul.
 // Score retourné: négatif au trait si l’adversaire vient de gagner (correction distance-mate incluse).
 bool MinimaxSearch::isTerminal(const Board& board, int ply, int& outScore) const
@@ -338,31 +828,53 @@ bool MinimaxSearch::isTerminal(const Board& board, int ply, int& outScore) const
     return false;
 }
 
-// Interroge la TT: si une entrée suffisante existe, fournit un bound et/ou un coup d’appoint.
-// TODO (plus tard): clé zobrist, profondeur, flags (Exact/Lower/Upper), meilleur coup pour l’ordre.
-bool MinimaxSearch::ttProbe(const Board& board, int depth, int alpha, int beta, int& outScore, std::optional<Move>& ttMove, TranspositionTable::Flag& outFlag) const
+// Les scores de mat sont stockés en distance depuis le nœud (et non depuis la racine):
+// la même position atteinte à un autre ply garde une distance au mat exacte.
+int MinimaxSearch::scoreToTT(int score, int ply)
 {
-    // TODO: Chercher dans tt, vérifier profondeur, renvoyer score/flag/move si applicable.
-    (void)board;
-    (void)depth;
-    (void)alpha;
-    (void)beta;
-    (void)outScore;
-    (void)ttMove;
-    (void)outFlag;
+    if (score >= MATE_SCORE - PvTable::MAX_PLY)
+        return score + ply;
+    if (score <= -MATE_SCORE + PvTable::MAX_PLY)
+        return score - ply;
+    return score;
+}
+
+int MinimaxSearch::scoreFromTT(int score, int ply)
+{
+    if (score >= MATE_SCORE - PvTable::MAX_PLY)
+        return score - ply;
+    if (score <= -MATE_SCORE + PvTable::MAX_PLY)
+        return score + ply;
+    return score;
+}
+
+// Interroge la TT: fournit le coup d'appoint sur tout hit, et true si la borne stockée
+// (assez profonde) tranche le nœud pour cette fenêtre.
+bool MinimaxSearch::ttProbe(Worker& w, int depth, int alpha, int beta, int ply, int& outScore, PackedMove& ttMove)
+{
+    ++w.ttProbes;
+    TranspositionTable::Hit hit;
+    if (!tt.probe(w.board->zobristKey(), hit))
+        return false;
+    ++w.ttHits;
+    ttMove = hit.best;
+    if (hit.depth < depth)
+        return false;
+    const int score = scoreFromTT(hit.score, ply);
+    using Flag = TranspositionTable::Flag;
+    if (hit.flag == Flag::Exact || (hit.flag == Flag::Lower && score >= beta) || (hit.flag == Flag::Upper && score <= alpha)) {
+        outScore = score;
+        return true;
+    }
     return false;
 }
 
-// Stocke un résultat dans la TT (clé, profondeur, score, flag, meilleur coup).
-// TODO (plus tard): politique de remplacement (plus profond/plus récent), correction des scores de mate pour l’indexation.
-void MinimaxSearch::ttStore(const Board& board, int depth, int score, TranspositionTable::Flag flag, const std::optional<Move>& best)
+// Stocke un résultat dans la TT (clé, profondeur, score, flag, meilleur coup);
+// le remplacement (profondeur, génération) est décidé par la table.
+void MinimaxSearch::ttStore(Worker& w, int depth, int ply, int score, TranspositionTable::Flag flag, PackedMove best)
 {
-    // TODO: Calculer zobrist, remplir l'entrée, politique de remplacement.
-    (void)board;
-    (void)depth;
-    (void)score;
-    (void)flag;
-    (void)best;
+    if (tt.store(w.board->zobristKey(), depth, scoreToTT(score, ply), flag, best))
+        ++w.ttCollisions;
 }
 
 // --- Helpers extracted from bestMove ---
@@ -370,7 +882,8 @@ void MinimaxSearch::ttStore(const Board& board, int depth, int score, Transposit
 //  - Ne teste que si plausible: ≥4 pierres posées (alignement possible en 1) ou ≥4 paires capturées (capture-win possible).
 //  - Joue spéculativement chaque candidat; si status devient WinByAlign/WinByCapture, retourne ce coup immédiatement.
 //  - Laisse les règles gérer les interdits (double-trois, overline (6+)) via tryPlay/status.
-std::optional<Move> MinimaxSearch::tryImmediateWinShortcut(Board& board, const RuleSet& rules, Player toPlay, const std::vector<Move>& candidates) const
+template <RuleVariant V>
+std::optional<Move> MinimaxSearch::tryImmediateWinShortcut(Board& board, const RuleSet& rules, Player toPlay, const MoveList& candidates) const
 {
 
     const bool plausibleAlign = board.stoneCount(toPlay) >= 4;
@@ -382,8 +895,9 @@ std::optional<Move> MinimaxSearch::tryImmediateWinShortcut(Board& board, const R
     if (!plausibleAlign && !plausibleCaptureWin)
         return std::nullopt;
 
-    for (const auto& m : candidates) {
-        auto pr = board.tryPlay(m, rules);
+    for (const PackedMove pm : candidates) {
+        const Move m = pm.toMove(toPlay);
+        auto pr = board.tryPlayFor<V>(m, rules);
         if (!pr.success)
             continue; // skip illegal candidates, don't abort early
         const auto st = board.status();
@@ -394,55 +908,78 @@ std::optional<Move> MinimaxSearch::tryImmediateWinShortcut(Board& board, const R
     return std::nullopt;
 }
 
-bool MinimaxSearch::runDepth(int depth, Board& board, const RuleSet& rules, Player toPlay, const std::vector<Move>& rootCandidates, std::optional<Move>& best, int& bestScore, std::vector<Move>& pv, long long& nodes, const SearchContext& ctx)
+template <RuleVariant V>
+bool MinimaxSearch::runDepth(Worker& w, int depth, const RuleSet& rules, Player toPlay, const MoveList& rootCandidates, std::optional<Move>& best, int& bestScore, std::vector<Move>& pv, long long& nodes, const SearchContext& ctx)
 {
-    if (cutoffByTime(ctx) || Clock::now() >= ctx.deadline)
+    if (ctx.stop.load(std::memory_order_relaxed) || cutoffByTime(ctx, w.nodes & 1023))
         return false;
+    Board& board = *w.board;
 
-    std::optional<Move> ttRootMove;
+    // À la racine la TT ne sert qu'à l'ordre des coups
+    PackedMove ttRootMove = PackedMove::none();
     int ttScore = 0;
-    TranspositionTable::Flag ttFlag = TranspositionTable::Flag::Exact;
-    (void)ttProbe(board, depth, -INF, INF, ttScore, ttRootMove, ttFlag);
+    (void)ttProbe(w, depth, -INF, INF, /*ply*/ 0, ttScore, ttRootMove);
 
-    auto ordered = orderMoves(board, rules, toPlay, ttRootMove);
+    // Scratch de l'itération dans l'arène (remise à zéro à chaque profondeur)
+    w.arena.reset();
+    MoveList* list = w.arena.allocate<MoveList>();
+    if (!list)
+        return false;
+    MoveList& ordered = *list;
+    orderMoves<V>(board, rules, toPlay, ttRootMove, ordered);
     if (ordered.empty())
         ordered = rootCandidates; // fallback
+    // Meilleur coup de l'itération précédente d'abord, puis sa PV dans l'arbre
+    w.followPv = w.prevPvLength > 0 && promote(ordered, w.prevPv[0]);
 
-    int alpha = -INF, beta = INF;
+    const int beta = INF;
+    int alpha = -INF;
     std::optional<Move> depthBest;
     int depthBestScore = -INF;
-    std::vector<Move> depthPV;
+    w.pvTable.clear(0);
 
-    for (const auto& m : ordered) {
-        if (cutoffByTime(ctx) || Clock::now() >= ctx.deadline)
-            break;
-        auto pr = board.tryPlay(m, rules);
+    for (const PackedMove pm : ordered) {
+        const Move m = pm.toMove(toPlay);
+        auto pr = board.tryPlayFor<V>(m, rules);
         if (!pr.success)
             continue;
-        std::vector<Move> childPV;
-        int childScore = negamax(board, depth - 1, -beta, -alpha, /*ply*/ 1, childPV, ctx);
-        int score = -childScore;
-        ++nodes;
+        w.path[0] = pm;
+        // PVS à la racine: fenêtre nulle après le premier coup, relance si elle est dépassée
+        int score;
+        if (!depthBest) {
+            score = -negamax<V>(w, depth - 1, -beta, -alpha, /*ply*/ 1, ctx);
+        } else {
+            score = -negamax<V>(w, depth - 1, -alpha - 1, -alpha, /*ply*/ 1, ctx);
+            if (score > alpha && !w.aborted)
+                score = -negamax<V>(w, depth - 1, -beta, -alpha, /*ply*/ 1, ctx);
+        }
         board.undo();
+        if (w.aborted)
+            break;
 
         if (score > depthBestScore) {
             depthBestScore = score;
             depthBest = m;
-            depthPV.clear();
-            depthPV.push_back(m);
-            depthPV.insert(depthPV.end(), childPV.begin(), childPV.end());
+            w.pvTable.update(0, pm); // coup + ligne de l'enfant (ligne 1)
         }
         if (score > alpha)
             alpha = score;
     }
+    nodes = static_cast<long long>(w.nodes);
 
-    if (!depthBest)
+    // Itération interrompue: ses scores sont partiels, on garde la précédente s'il y en a une
+    if (!depthBest || (w.aborted && best))
         return false;
 
     best = depthBest;
     bestScore = depthBestScore;
-    pv = depthPV;
-    ttStore(board, depth, bestScore, TranspositionTable::Flag::Exact, best);
+    w.pvTable.copyLine(0, toPlay, pv);
+    w.prevPvLength = w.pvTable.size(0);
+    for (int i = 0; i < w.prevPvLength; ++i)
+        w.prevPv[i] = w.pvTable.at(0, i);
+    if (w.aborted)
+        return false;
+    ttStore(w, depth, /*ply*/ 0, bestScore, TranspositionTable::Flag::Exact, PackedMove(*best));
     return true;
 }
 } // namespace gomoku
@@ -1,22 +1,44 @@
 #include "gomoku/ai/MinimaxSearchEngine.hpp"
 #include "gomoku/core/Board.hpp"
+#include "gomoku/core/Logger.hpp"
 #include "gomoku/interfaces/IBoardView.hpp"
-#include <stdexcept>
 
 namespace gomoku::ai {
 
 MinimaxSearchEngine::MinimaxSearchEngine()
     : searchImpl_(SearchConfig {})
     , config_ {}
+    , board_(std::make_unique<Board>())
 {
 }
 
 MinimaxSearchEngine::MinimaxSearchEngine(const SearchConfig& config)
     : searchImpl_(config)
     , config_(config)
+    , board_(std::make_unique<Board>())
 {
 }
 
+MinimaxSearchEngine::~MinimaxSearchEngine() = default;
+
+void MinimaxSearchEngine::onNewGame()
+{
+    board_->reset();
+    synced_ = true;
+}
+
+void MinimaxSearchEngine::onMovePlayed(const Move& move, const RuleSet& rules)
+{
+    if (synced_ && !board_->tryPlay(move, rules).success)
+        synced_ = false; // désynchronisé: resynchronisation à la prochaine recherche
+}
+
+void MinimaxSearchEngine::onUndo()
+{
+    if (synced_ && !board_->undo())
+        synced_ = false;
+}
+
 void MinimaxSearchEngine::setTimeLimit(int milliseconds)
 {
     config_.timeBudgetMs = milliseconds;
@@ -35,16 +57,31 @@ void MinimaxSearchEngine::setTranspositionTableSize(size_t bytes)
     searchImpl_.setTranspositionTableSize(bytes);
 }
 
+void MinimaxSearchEngine::setThreadCount(int threads)
+{
+    searchImpl_.setThreads(threads);
+    config_.threads = threads < 1 ? 1 : threads;
+}
+
 std::optional<Move> MinimaxSearchEngine::findBestMove(
     const IBoardView& board,
     const RuleSet& rules,
     SearchStats* stats)
 {
-    // Convert IBoardView to concrete Board for MinimaxSearch class
-    Board concreteBoard = boardFromView(board);
+    // Position tenue à jour par les notifications: recherche sans copie.
+    // Sinon (moteur branché en cours de partie), une copie unique resynchronise board_.
+    if (!holds(board)) {
+        const Board* view = boardFor(board);
+        if (!view) {
+            LOG_ERROR("Search engine needs a gomoku::Board view or move notifications");
+            lastStats_ = SearchStats {};
+            return std::nullopt;
+        }
+        *board_ = *view;
+        synced_ = true;
+    }
 
-    // Use existing MinimaxSearch implementation
-    auto result = searchImpl_.bestMove(concreteBoard, rules, stats);
+    auto result = searchImpl_.bestMove(*board_, rules, stats);
     lastStats_ = stats ? *stats : SearchStats {};
 
     return result;
@@ -68,15 +105,22 @@ std::optional<Move> MinimaxSearchEngine::suggestMove(
 
 int MinimaxSearchEngine::evaluatePosition(const IBoardView& board, Player perspective) const
 {
-    Board concreteBoard = boardFromView(board);
-    return searchImpl_.evaluatePublic(concreteBoard, perspective);
+    const Board* b = boardFor(board);
+    if (!b) {
+        LOG_ERROR("Search engine needs a gomoku::Board view or move notifications");
+        return 0;
+    }
+    return searchImpl_.evaluatePublic(*b, perspective);
 }
 
 std::vector<Move> MinimaxSearchEngine::getOrderedMoves(const IBoardView& board, const RuleSet& rules) const
 {
-    Board concreteBoard = boardFromView(board);
-    Player toPlay = concreteBoard.toPlay();
-    return searchImpl_.orderedMovesPublic(concreteBoard, rules, toPlay);
+    const Board* b = boardFor(board);
+    if (!b) {
+        LOG_ERROR("Search engine needs a gomoku::Board view or move notifications");
+        return {};
+    }
+    return searchImpl_.orderedMovesPublic(*b, rules, b->toPlay());
 }
 
 void MinimaxSearchEngine::clearTranspositionTable()
@@ -89,13 +133,17 @@ SearchStats MinimaxSearchEngine::getLastSearchStats() const
     return lastStats_;
 }
 
-// Helper method to convert IBoardView to concrete Board
-gomoku::Board MinimaxSearchEngine::boardFromView(const IBoardView& view) const
+// La clé Zobrist couvre pierres, trait et paires capturées
+bool MinimaxSearchEngine::holds(const IBoardView& view) const
 {
-    if (auto concreteBoard = dynamic_cast<const gomoku::Board*>(&view)) {
-        return *concreteBoard;
-    }
-    return gomoku::Board {}; // production fallback
+    return synced_ && board_->zobristKey() == view.zobristKey() && board_->status() == view.status();
+}
+
+const gomoku::Board* MinimaxSearchEngine::boardFor(const IBoardView& view) const
+{
+    if (holds(view))
+        return board_.get();
+    return dynamic_cast<const gomoku::Board*>(&view);
 }
 
 } // namespace gomoku::ai
\ No newline at end of file
@@ -0,0 +1,473 @@
+#include "gomoku/ai/ThreatSolver.hpp"
+#include "gomoku/core/Board.hpp"
+#include <algorithm>
+#include <array>
+
+namespace gomoku {
+
+namespace {
+    using Mailbox = Board::Mailbox;
+    constexpr int DX[4] = { 1, 0, 1, 1 };
+    constexpr int DY[4] = { 0, 1, 1, -1 };
+    // Les résultats VCT ne valent pas pour une recherche VCF: clés séparées dans le cache
+    constexpr uint64_t VCT_SALT = 0x9E3779B97F4A7C15ull;
+    // Profondeur d'un échec acquis quelle que soit la profondeur demandée
+    constexpr uint8_t ANY_DEPTH = 255;
+
+    // Ligne de 2 * REACH + 1 cases centrée sur une case, vue par un joueur
+    constexpr int REACH = 9;
+    constexpr int SPAN = 2 * REACH + 1;
+    enum : uint8_t { EMPTY,
+        MINE,
+        BLOCKED }; // pierre adverse ou hors plateau
+    using Line = std::array<uint8_t, SPAN>;
+
+    Pos along(Pos p, int d, int k) { return { static_cast<uint8_t>(p.x + k * DX[d]), static_cast<uint8_t>(p.y + k * DY[d]) }; }
+
+    // Lecture dans la mailbox, du centre vers l'extérieur: la bordure (WALL) arrête
+    // chaque rayon avant qu'il ne sorte de la grille, au-delà tout est bloqué
+    Line readLine(const Mailbox& mb, Pos p, int d, uint8_t me)
+    {
+        Line l;
+        l.fill(BLOCKED);
+        const int c = Mailbox::padded(p.x, p.y);
+        l[REACH] = mb[c] == Mailbox::EMPTY ? EMPTY : (mb[c] == me ? MINE : BLOCKED);
+        for (int sg = -1; sg <= 1; sg += 2) {
+            for (int k = 1; k <= REACH; ++k) {
+                const uint8_t v = mb[c + sg * k * Mailbox::OFFSET[d]];
+                if (v == Mailbox::WALL)
+                    break;
+                l[static_cast<std::size_t>(REACH + sg * k)] = v == Mailbox::EMPTY ? EMPTY : (v == me ? MINE : BLOCKED);
+            }
+        }
+        return l;
+    }
+
+    // Poser en i (case vide de la ligne) aligne-t-il cinq pierres ou plus ?
+    bool fiveAt(const Line& l, int i)
+    {
+        int run = 1;
+        for (int j = i - 1; j >= 0 && l[static_cast<std::size_t>(j)] == MINE; --j)
+            ++run;
+        for (int j = i + 1; j < SPAN && l[static_cast<std::size_t>(j)] == MINE; ++j)
+            ++run;
+        return run >= 5;
+    }
+
+    // Cases vides à au plus 'reach' du centre qui complètent un cinq (indices dans where)
+    int completions(const Line& l, int reach, std::array<int, SPAN>* where = nullptr)
+    {
+        int n = 0;
+        for (int i = REACH - reach; i <= REACH + reach; ++i) {
+            if (l[static_cast<std::size_t>(i)] != EMPTY || !fiveAt(l, i))
+                continue;
+            if (where)
+                (*where)[static_cast<std::size_t>(n)] = i;
+            ++n;
+        }
+        return n;
+    }
+
+    // Trois: un coup de plus près du centre donne un quatre droit (deux cases de cinq)
+    bool threeIn(Line l)
+    {
+        int mine = 0;
+        for (int i = REACH - 4; i <= REACH + 4; ++i)
+            mine += l[static_cast<std::size_t>(i)] == MINE;
+        if (mine < 3)
+            return false;
+        for (int y = REACH - 4; y <= REACH + 4; ++y) {
+            auto& cell = l[static_cast<std::size_t>(y)];
+            if (cell != EMPTY)
+                continue;
+            cell = MINE;
+            const bool open = completions(l, 5) >= 2;
+            cell = EMPTY;
+            if (open)
+                return true;
+        }
+        return false;
+    }
+
+    // who jouant en p aligne-t-il cinq ? (rayons directs dans la mailbox)
+    bool makesFive(const Mailbox& mb, Pos p, uint8_t who)
+    {
+        const int c = Mailbox::padded(p.x, p.y);
+        for (int d = 0; d < 4; ++d) {
+            const int o = Mailbox::OFFSET[d];
+            int run = 1;
+            for (int k = 1; k < 5 && mb[c + k * o] == who; ++k)
+                ++run;
+            for (int k = 1; k < 5 && mb[c - k * o] == who; ++k)
+                ++run;
+            if (run >= 5)
+                return true;
+        }
+        return false;
+    }
+
+    struct Threat {
+        int fours = 0; // cases de cinq créées
+        bool three = false;
+    };
+
+    // Pierres de me sur la ligne d de part et d'autre de c (exclue): à quatre cases au plus
+    // (near) et de cinq à huit cases (far)
+    void stonesAround(const Mailbox& mb, int c, int d, uint8_t me, int& near, int& far)
+    {
+        near = far = 0;
+        for (int sg = -1; sg <= 1; sg += 2)
+            for (int k = 1; k <= 8; ++k) {
+                const uint8_t v = mb[c + sg * k * Mailbox::OFFSET[d]];
+                if (v == Mailbox::WALL)
+                    break;
+                if (v == me)
+                    ++(k <= 4 ? near : far);
+            }
+    }
+
+    // Menace que me crée en jouant c (hypothétique: les captures du coup sont ignorées).
+    // Une direction n'est lue que si elle peut compter: un cinq complété à quatre cases de c
+    // demande trois autres pierres à portée, ou quatre dans les huit cases (quatre déjà
+    // posé à côté de c); un trois en demande deux à quatre cases.
+    Threat classify(const Mailbox& mb, Pos c, uint8_t me, bool wantThree)
+    {
+        Threat t;
+        const int center = Mailbox::padded(c.x, c.y);
+        for (int d = 0; d < 4; ++d) {
+            int near = 0, far = 0;
+            stonesAround(mb, center, d, me, near, far);
+            const bool four = near >= 3 || near + far >= 4;
+            if (!four && !(wantThree && !t.three && !t.fours && near >= 2))
+                continue;
+            Line l = readLine(mb, c, d, me);
+            l[REACH] = MINE;
+            t.fours += completions(l, 4);
+            if (wantThree && !t.three && !t.fours)
+                t.three = threeIn(l);
+        }
+        return t;
+    }
+
+    // Coups de l'adversaire de who qui préparent la prise d'une paire contenant s
+    // (_ s t _: il joue un bout et menace de prendre en jouant l'autre)
+    void addCaptureSetups(const Mailbox& mb, int s, uint8_t who, Board::CellSet& out)
+    {
+        for (int d = 0; d < Mailbox::DIRS; ++d) {
+            const int o = Mailbox::OFFSET[d];
+            if (mb[s + o] == who && mb[s - o] == Mailbox::EMPTY && mb[s + 2 * o] == Mailbox::EMPTY) {
+                out.set(Mailbox::boardIndex(s - o));
+                out.set(Mailbox::boardIndex(s + 2 * o));
+            }
+        }
+    }
+
+    // Même chose pour toutes les pierres de who sur la ligne d autour de c
+    void addLineSetups(const Mailbox& mb, Pos c, int d, uint8_t who, Board::CellSet& out)
+    {
+        const int center = Mailbox::padded(c.x, c.y);
+        for (int sg = -1; sg <= 1; sg += 2)
+            for (int k = sg < 0 ? 1 : 0; k <= 4; ++k) {
+                const int s = center + sg * k * Mailbox::OFFSET[d];
+                if (mb[s] == Mailbox::WALL)
+                    break;
+                if (mb[s] == who)
+                    addCaptureSetups(mb, s, who, out);
+            }
+    }
+
+    void frontierCells(const Board& b, MoveList& out)
+    {
+        out.clear();
+        for (const Pos& p : b.frontierPositions())
+            out.push_back(p);
+    }
+
+    // Fenêtre de cinq cases passant par s (pierre de me) sans bord ni pierre adverse, avec au
+    // moins trois pierres de me: un coup de plus y fait un quatre (ou un cinq)
+    bool fourWindow(const Mailbox& mb, int s, uint8_t me)
+    {
+        for (int d = 0; d < 4; ++d) {
+            const int o = Mailbox::OFFSET[d];
+            for (int start = -4; start <= 0; ++start) {
+                int mine = 0, k = start;
+                for (; k < start + 5; ++k) {
+                    const uint8_t v = mb[s + k * o];
+                    if (v == me)
+                        ++mine;
+                    else if (v != Mailbox::EMPTY)
+                        break;
+                }
+                if (k == start + 5 && mine >= 3)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool isWin(GameStatus st) { return st == GameStatus::WinByAlign || st == GameStatus::WinByCapture; }
+} // namespace
+
+ThreatSolver::ThreatSolver(std::size_t cacheEntries)
+{
+    std::size_t count = 1;
+    while (count * 2 <= cacheEntries)
+        count <<= 1;
+    cache = std::make_unique<CacheEntry[]>(count);
+    mask = count - 1;
+}
+
+void ThreatSolver::clearCache()
+{
+    std::fill(cache.get(), cache.get() + mask + 1, CacheEntry {});
+}
+
+// Les pierres du joueur au trait seulement (quelques dizaines), sans jouer de coup
+bool ThreatSolver::canStartVcf(const Board& board, const RuleSet& rules)
+{
+    if (board.status() != GameStatus::Ongoing)
+        return false;
+    const Player me = board.toPlay();
+    const RuleVariant v = rules.variant();
+    if (v.captures) {
+        const auto caps = board.capturedPairs();
+        const int pairs = me == Player::Black ? caps.black : caps.white;
+        if (pairs + 2 >= rules.captureWinPairs && board.captureMask(me).any())
+            return true;
+    }
+    if (!v.alignWins)
+        return false;
+    const Mailbox& mb = board.mailbox();
+    const uint8_t meC = Mailbox::code(playerToCell(me));
+    for (const Pos& p : board.occupiedPositions()) {
+        const int s = Mailbox::padded(p.x, p.y);
+        if (mb[s] == meC && fourWindow(mb, s, meC))
+            return true;
+    }
+    return false;
+}
+
+ThreatSolver::Result ThreatSolver::solve(Board& board, const RuleSet& rules, Mode m, int maxAttacks, long long nodeBudget)
+{
+    mode = m;
+    nodes = 0;
+    budget = nodeBudget;
+    exhausted = false;
+    Result r;
+    if (board.status() != GameStatus::Ongoing || maxAttacks <= 0)
+        return r;
+    // Approfondissement itératif: le gain le plus court d'abord, et une branche profonde
+    // sans issue ne consomme pas tout le budget avant les menaces voisines
+    PackedMove first = PackedMove::none();
+    const int attacks = withRuleVariant(rules.variant(), [&]<RuleVariant V>() {
+        for (int depth = 1; depth <= maxAttacks && !exhausted; ++depth)
+            if (const int n = attack<V>(board, rules, depth, first))
+                return n;
+        return 0;
+    });
+    if (attacks) {
+        r.move = first.toMove(board.toPlay());
+        r.plies = 2 * attacks - 1;
+    }
+    r.nodes = nodes;
+    return r;
+}
+
+// Nœud OU (attaquant au trait):
+//  1) gain immédiat (cinq non cassable, capture gagnante), vérifié en jouant;
+//  2) un cinq adverse en préparation doit être paré: seul ce coup est essayé, et
+//     seulement s'il menace aussi (deux cinq adverses: échec);
+//  3) sinon les quatre, puis en VCT les trois, chacun suivi de toutes les parades utiles.
+template <RuleVariant V>
+int ThreatSolver::attack(Board& board, const RuleSet& rules, int depth, PackedMove& move)
+{
+    const Player me = board.toPlay();
+    const Mailbox& mb = board.mailbox();
+    const uint8_t meC = Mailbox::code(playerToCell(me)), oppC = Mailbox::code(playerToCell(opponent(me)));
+    const uint64_t key = board.zobristKey() ^ (mode == Mode::Vct ? VCT_SALT : 0);
+    CacheEntry& slot = cache[key & mask];
+    if (slot.key == key) {
+        if (slot.win && slot.win <= depth) {
+            move = slot.move;
+            return slot.win;
+        }
+        if (!slot.win && slot.depth >= depth)
+            return 0;
+    }
+    // settled: aucun coup d'attaque n'existe, l'échec vaut pour toute profondeur
+    auto remember = [&](int win, PackedMove best, bool settled = false) {
+        if (!win && exhausted)
+            return; // échec dû au budget: rien de prouvé
+        slot = { key, best, static_cast<uint8_t>(settled ? ANY_DEPTH : depth), static_cast<uint8_t>(win) };
+    };
+
+    MoveList cells;
+    frontierCells(board, cells);
+    const Board::CellSet legal = board.legalMaskFor<V>(me, rules);
+
+    const auto caps = board.capturedPairs();
+    const int pairs = me == Player::Black ? caps.black : caps.white;
+    const bool captureWinNear = V.captures && pairs + 2 >= rules.captureWinPairs;
+    for (const PackedMove pm : cells) {
+        const bool five = V.alignWins && makesFive(mb, pm.pos(), meC);
+        if (!five && !(captureWinNear && board.captureMask(me).test(pm.index())))
+            continue;
+        if (!legal.test(pm.index()))
+            continue;
+        board.doMoveFor<V>(pm.toMove(me), rules);
+        ++nodes;
+        const bool won = isWin(board.status());
+        board.undoMove();
+        if (won) {
+            move = pm;
+            remember(1, pm);
+            return 1;
+        }
+    }
+    if (!V.alignWins || depth <= 1 || outOfBudget()) {
+        remember(0, PackedMove::none());
+        return 0;
+    }
+
+    Board::CellSet oppFives;
+    for (const PackedMove pm : cells)
+        if (makesFive(mb, pm.pos(), oppC))
+            oppFives.set(pm.index());
+    const int forced = oppFives.count();
+    if (forced >= 2) {
+        remember(0, PackedMove::none(), true);
+        return 0;
+    }
+
+    MoveList fours, threes;
+    for (const PackedMove pm : cells) {
+        if (forced && !oppFives.test(pm.index()))
+            continue;
+        const Threat t = classify(mb, pm.pos(), meC, mode == Mode::Vct);
+        if (t.fours)
+            fours.push_back(pm);
+        else if (t.three)
+            threes.push_back(pm);
+    }
+    if (fours.empty() && threes.empty()) {
+        remember(0, PackedMove::none(), true);
+        return 0;
+    }
+
+    for (const MoveList* list : { &fours, &threes }) {
+        for (const PackedMove pm : *list) {
+            if (!legal.test(pm.index()))
+                continue;
+            board.doMoveFor<V>(pm.toMove(me), rules);
+            ++nodes;
+            const GameStatus st = board.status();
+            int win = isWin(st) ? 1 : 0; // capture gagnante non repérée plus haut
+            if (st == GameStatus::Ongoing) {
+                const int rest = defend<V>(board, rules, depth - 1, pm.pos());
+                win = rest ? rest + 1 : 0;
+            }
+            board.undoMove();
+            if (win) {
+                move = pm;
+                remember(win, pm);
+                return win;
+            }
+            if (outOfBudget())
+                return 0;
+        }
+    }
+    remember(0, PackedMove::none());
+    return 0;
+}
+
+// Nœud ET (défenseur au trait, l'attaquant vient de jouer 'threat'). Parades essayées:
+// cases qui arrêtent la menace (cases de cinq d'un quatre, cases qui désamorcent un trois),
+// toutes les captures, préparations de capture des pierres menaçantes et cinq du défenseur.
+// Un trois auquel le défenseur peut répondre par un quatre n'est pas poursuivi.
+template <RuleVariant V>
+int ThreatSolver::defend(Board& board, const RuleSet& rules, int depth, Pos threat)
+{
+    const Player def = board.toPlay();
+    const Mailbox& mb = board.mailbox();
+    const uint8_t defC = Mailbox::code(playerToCell(def)), attC = Mailbox::code(playerToCell(opponent(def)));
+
+    // Parades directes d'abord (elles réfutent le plus souvent), puis les autres
+    Board::CellSet blocks, others;
+    bool four = false;
+    std::array<int, SPAN> where;
+    for (int d = 0; d < 4; ++d) {
+        const Line l = readLine(mb, threat, d, attC);
+        const int n = completions(l, 4, &where);
+        for (int i = 0; i < n; ++i)
+            blocks.set(along(threat, d, where[static_cast<std::size_t>(i)] - REACH).toIndex());
+        if (n) {
+            four = true;
+            if constexpr (V.captures)
+                addLineSetups(mb, threat, d, attC, others);
+        }
+    }
+
+    MoveList cells;
+    frontierCells(board, cells);
+    if (!four) {
+        if (mode != Mode::Vct)
+            return 0;
+        bool three = false;
+        for (int d = 0; d < 4; ++d) {
+            Line l = readLine(mb, threat, d, attC);
+            if (!threeIn(l))
+                continue;
+            three = true;
+            for (int z = REACH - 5; z <= REACH + 5; ++z) {
+                auto& cell = l[static_cast<std::size_t>(z)];
+                if (cell != EMPTY)
+                    continue;
+                cell = BLOCKED;
+                if (!threeIn(l))
+                    blocks.set(along(threat, d, z - REACH).toIndex());
+                cell = EMPTY;
+            }
+            if constexpr (V.captures)
+                addLineSetups(mb, threat, d, attC, others);
+        }
+        if (!three)
+            return 0;
+        for (const PackedMove pm : cells)
+            if (classify(mb, pm.pos(), defC, false).fours)
+                return 0; // le défenseur reprend l'initiative par un quatre
+    }
+
+    for (const PackedMove pm : cells) {
+        if (makesFive(mb, pm.pos(), defC))
+            blocks.set(pm.index());
+        // Avec les captures, le cinq de l'attaquant peut être cassé: un contre-quatre compte
+        else if (V.captures && four && classify(mb, pm.pos(), defC, false).fours)
+            others.set(pm.index());
+    }
+    if constexpr (V.captures)
+        others |= board.captureMask(def);
+    others.subtract(blocks);
+
+    int longest = 0;
+    bool tried = false;
+    const Board::CellSet legal = board.legalMaskFor<V>(def, rules);
+    auto refutes = [&](int id) {
+        if (!legal.test(id))
+            return false;
+        tried = true;
+        board.doMoveFor<V>({ Pos::fromIndex(static_cast<uint16_t>(id)), def }, rules);
+        ++nodes;
+        PackedMove next = PackedMove::none();
+        const int n = board.status() == GameStatus::Ongoing ? attack<V>(board, rules, depth, next) : 0;
+        board.undoMove();
+        longest = std::max(longest, n);
+        return n == 0;
+    };
+    const bool refuted = blocks.anyOf(refutes) || others.anyOf(refutes);
+    // Aucune parade légale dans l'ensemble: on ne conclut pas (prudence)
+    if (refuted || !tried)
+        return 0;
+    return longest;
+}
+
+} // namespace gomoku
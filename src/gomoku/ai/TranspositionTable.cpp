@@ -0,0 +1,93 @@
+#include "gomoku/ai/TranspositionTable.hpp"
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace gomoku {
+
+namespace {
+    constexpr std::size_t HUGE_PAGE = std::size_t { 2 } << 20;
+}
+
+void TranspositionTable::resizeBytes(std::size_t bytes)
+{
+    if (!bytes)
+        bytes = (16ull << 20);
+    std::size_t count = 1024; // au moins 64 KiB
+    while (count * 2 * sizeof(Bucket) <= bytes)
+        count <<= 1;
+
+    // Alignée sur 2 MiB quand la table le permet: le noyau peut alors la servir en pages énormes
+    const std::size_t total = count * sizeof(Bucket);
+    const std::size_t align = total >= HUGE_PAGE ? HUGE_PAGE : alignof(Bucket);
+    buckets.reset();
+    void* raw = std::aligned_alloc(align, total);
+    if (!raw)
+        throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (align == HUGE_PAGE)
+        madvise(raw, total, MADV_HUGEPAGE);
+#endif
+    buckets.reset(static_cast<Bucket*>(raw));
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear()
+{
+    if (!buckets)
+        return;
+    for (std::size_t i = 0; i <= mask; ++i)
+        ::new (&buckets[i]) Bucket {};
+    generation = 0;
+}
+
+bool TranspositionTable::store(uint64_t key, int depth, int score, Flag flag, PackedMove best)
+{
+    if (!buckets)
+        return false;
+    Bucket& b = bucketOf(key);
+    // Instantané du bucket: les autres threads peuvent écrire pendant la décision
+    std::array<Entry, BUCKET_SLOTS> cur;
+    for (int i = 0; i < BUCKET_SLOTS; ++i)
+        cur[i] = load(b.slots[i]);
+    const auto meta = static_cast<uint8_t>(generation << GEN_SHIFT | USED | static_cast<uint8_t>(flag));
+    auto write = [&](int i) {
+        if (best.isNone() && cur[i].key == key)
+            best = cur[i].best; // garder le coup connu de la position
+        save(b.slots[i], { key, score, best, static_cast<int8_t>(depth), meta });
+    };
+
+    // Même position: mise à jour sur place, sauf un résultat plus profond et non exact du même tour
+    for (int i = 0; i < BUCKET_SLOTS; ++i) {
+        const Entry& e = cur[i];
+        if (e.key != key || !(e.meta & USED))
+            continue;
+        if (i == ALWAYS_SLOT || depth >= e.depth || flag == Flag::Exact || age(e) != 0)
+            write(i);
+        return false;
+    }
+
+    // Cases "profondeur d'abord": la moins utile (vide, puis ancienne, puis peu profonde)
+    int victim = 0;
+    auto worth = [&](const Entry& e) { return (e.meta & USED) ? e.depth - 8 * age(e) : -1000; };
+    for (int i = 1; i < ALWAYS_SLOT; ++i)
+        if (worth(cur[i]) < worth(cur[victim]))
+            victim = i;
+    const Entry& v = cur[victim];
+    if (!(v.meta & USED) || age(v) != 0 || depth >= v.depth) {
+        const bool collided = (v.meta & USED) && age(v) == 0;
+        write(victim);
+        return collided;
+    }
+
+    // Sinon la case "toujours remplacer"
+    const Entry& last = cur[ALWAYS_SLOT];
+    const bool collided = (last.meta & USED) && age(last) == 0;
+    write(ALWAYS_SLOT);
+    return collided;
+}
+
+} // namespace gomoku
@@ -18,12 +18,16 @@ void GameService::startNewGame(const RuleSet& rules)
     rules_ = rules;
     board_->reset();
     moveHistory_.clear();
+    if (searchEngine_)
+        searchEngine_->onNewGame();
 }
 
 void GameService::reset()
 {
     board_->reset();
     moveHistory_.clear();
+    if (searchEngine_)
+        searchEngine_->onNewGame();
 }
 
 GameStatus GameService::getGameStatus() const
@@ -44,26 +48,17 @@ PlayResult GameService::makeMove(const Position& pos)
 
 PlayResult GameService::makeMove(const Move& move)
 {
-    // Validate the move first
-    std::string reason;
-    if (!isMoveLegal(move, &reason)) {
-        PlayErrorCode code = PlayErrorCode::RuleViolation;
-        if (reason == "Invalid position")
-            code = PlayErrorCode::InvalidPosition;
-        else if (reason == "Not this player's turn")
-            code = PlayErrorCode::NotPlayersTurn;
-        else if (reason == "Position already occupied")
-            code = PlayErrorCode::Occupied;
-        else if (reason == "Game already finished")
-            code = PlayErrorCode::GameFinished;
-        // Reste: RuleViolation (double-three, must-break...) déjà mappé
-        return PlayResult::fail(code, reason);
-    }
+    // Prévalidation bon marché, puis une seule passe du moteur de règles:
+    // tryPlay valide et joue, ou rejette avec le code d'erreur précis.
+    auto base = moveValidator_.validate(*board_, rules_, move);
+    if (!base.ok)
+        return PlayResult::fail(base.code, base.reason);
 
-    // Attempt to play the move
     auto result = board_->tryPlay(move, rules_);
     if (result.success) {
         moveHistory_.push_back(move);
+        if (searchEngine_)
+            searchEngine_->onMovePlayed(move, rules_);
     }
 
     return result;
@@ -83,6 +78,8 @@ bool GameService::undo()
     bool success = board_->undo();
     if (success && !moveHistory_.empty()) {
         moveHistory_.pop_back();
+        if (searchEngine_)
+            searchEngine_->onUndo();
     }
     return success;
 }
@@ -125,6 +122,12 @@ std::optional<Move> GameService::getAIMove(int timeMs)
 void GameService::setSearchEngine(std::unique_ptr<ISearchEngine> engine)
 {
     searchEngine_ = std::move(engine);
+    if (!searchEngine_)
+        return;
+    // Rejoue la partie en cours sur le plateau du moteur
+    searchEngine_->onNewGame();
+    for (const auto& m : moveHistory_)
+        searchEngine_->onMovePlayed(m, rules_);
 }
 
 bool GameService::validateMove(const Move& move, std::string* reason) const
@@ -136,10 +139,8 @@ bool GameService::validateMove(const Move& move, std::string* reason) const
         return false;
     }
 
-    auto self = const_cast<GameService*>(this);
-    PlayResult pr;
-    bool ok = self->board_->speculativeTry(move, rules_, &pr);
-    if (!ok) {
+    PlayResult pr = board_->checkMove(move, rules_);
+    if (!pr.success) {
         if (reason)
             *reason = pr.error;
         return false;
@@ -8,16 +8,18 @@ MoveValidator::Result MoveValidator::validate(const IBoardView& board, const Rul
     Result r;
 
     if (!move.isValid()) {
+        r.code = PlayErrorCode::InvalidPosition;
         r.reason = "Invalid position";
         return r;
     }
     if (board.status() != GameStatus::Ongoing) {
+        r.code = PlayErrorCode::GameFinished;
         r.reason = "Game already finished";
         return r;
     }
 
     // Prévalidation réussie; les règles complexes + tour + occupation sont
-    // vérifiées définitivement lors de l'appel à Board::tryPlay.
+    // vérifiées en une seule passe par Board::tryPlay (ou Board::checkMove).
     r.ok = true;
     return r;
 }
@@ -41,10 +41,8 @@ Controller SessionController::controller(Player side) const
 
 GamePlayResult SessionController::playHuman(Pos p)
 {
+    // makeMove valide et joue en une passe: pas de isMoveLegal préalable
     Move m { p, gameService_->getCurrentPlayer() };
-    std::string why;
-    if (!gameService_->isMoveLegal(m, &why))
-        return { false, why, std::nullopt, std::nullopt };
     auto res = gameService_->makeMove(m);
     if (!res.success)
         return { false, res.error, std::nullopt, std::nullopt };
@@ -1,7 +1,8 @@
 #include "gomoku/core/Board.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
-#include <random>
 #include <string>
 
 namespace gomoku {
@@ -10,159 +11,291 @@ namespace gomoku {
 
 // ------------------ Zobrist ------------------
 namespace {
-    std::array<uint64_t, 2 * BOARD_SIZE * BOARD_SIZE> Z_PCS {};
-    uint64_t Z_SIDE = 0;
+    using detail::ZOBRIST;
+    using detail::z_of;
+    using detail::z_pairs;
 
-    inline int flat(int x, int y) { return y * BOARD_SIZE + x; }
-    inline uint64_t z_of(Cell c, int x, int y)
+    // Image de chaque case par les 8 symétries du carré
+    template <int S>
+    constexpr std::array<std::array<uint16_t, S * S>, BasicBoard<S>::SYMMETRIES> makeSymIndex()
     {
-        if (c == Cell::Black)
-            return Z_PCS[0 * BOARD_SIZE * BOARD_SIZE + flat(x, y)];
-        if (c == Cell::White)
-            return Z_PCS[1 * BOARD_SIZE * BOARD_SIZE + flat(x, y)];
-        return 0ull;
+        std::array<std::array<uint16_t, S * S>, BasicBoard<S>::SYMMETRIES> t {};
+        for (int t0 = 0; t0 < BasicBoard<S>::SYMMETRIES; ++t0)
+            for (int id = 0; id < S * S; ++id) {
+                const Pos q = BasicBoard<S>::transform(Pos { static_cast<uint8_t>(id % S), static_cast<uint8_t>(id / S) }, t0);
+                t[t0][id] = static_cast<uint16_t>(q.y * S + q.x);
+            }
+        return t;
+    }
+
+    template <int S>
+    constexpr auto SYM_INDEX = makeSymIndex<S>();
+}
+
+// ------------------ Trois libres ------------------
+namespace {
+    // Cases à moins de 5 pas sur les 4 lignes de chaque case (elle comprise):
+    // ce sont celles dont la fenêtre de 11 cases voit la case changer.
+    template <int S>
+    constexpr std::array<BasicCellSet<S>, S * S> makeLineReach()
+    {
+        using BB = BasicBitboard<S>;
+        std::array<BasicCellSet<S>, S * S> t {};
+        for (int y = 0; y < S; ++y)
+            for (int x = 0; x < S; ++x)
+                for (int d = 0; d < BB::DIRS; ++d)
+                    for (int k = -5; k <= 5; ++k) {
+                        const int nx = x + k * BB::DX[d], ny = y + k * BB::DY[d];
+                        if (nx >= 0 && nx < S && ny >= 0 && ny < S)
+                            t[y * S + x].set(ny * S + nx);
+                    }
+        return t;
     }
 
-    struct ZInit {
-        ZInit()
+    template <int S>
+    constexpr std::array<BasicCellSet<S>, S * S> LINE_REACH = makeLineReach<S>();
+
+    // Fenêtre de 11 cases (k = -5..5) en codes relatifs au joueur: 0 vide, 1 moi, 2 adversaire, 3 mur.
+    // La case centrale (le coup joué) est implicite: index = 5 cases avant | 5 cases après << 10.
+    constexpr int FT_BITS = 20;
+    std::array<uint64_t, (1u << FT_BITS) / 64> FREE_THREE {};
+
+    inline uint32_t freeThreeIndex(uint32_t window) { return (window & 0x3FFu) | ((window >> 12) << 10); }
+
+    inline bool formsFreeThree(uint32_t window)
+    {
+        const uint32_t i = freeThreeIndex(window);
+        return (FREE_THREE[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    struct FreeThreeInit {
+        FreeThreeInit()
         {
-            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL); // seed fixe (reproductible)
-            for (auto& v : Z_PCS)
-                v = rng();
-            Z_SIDE = rng();
+            for (uint32_t i = 0; i < (1u << FT_BITS); ++i) {
+                uint32_t mine = 1u << 5, empty = 0;
+                for (int k = 0; k < 11; ++k) {
+                    if (k == 5)
+                        continue;
+                    const int c = k < 5 ? (i >> (2 * k)) & 3u : (i >> (2 * (k - 1))) & 3u;
+                    mine |= (c == 1 ? 1u : 0u) << k;
+                    empty |= (c == 0 ? 1u : 0u) << k;
+                }
+                const uint32_t m = mine, e = empty;
+                const bool three = (e & m >> 1 & m >> 2 & m >> 3 & e >> 4) // 0 111 0
+                    || (e & m >> 1 & e >> 2 & m >> 3 & m >> 4 & e >> 5) // 0 1 0 11 0
+                    || (e & m >> 1 & m >> 2 & e >> 3 & m >> 4 & e >> 5); // 0 11 0 1 0
+                if (three)
+                    FREE_THREE[i >> 6] |= 1ull << (i & 63);
+            }
         }
-    } ZINIT;
+    } FREE_THREE_INIT;
 }
+
+bool detail::isFreeThreeWindow(uint32_t window) { return formsFreeThree(window); }
 // ------------------------------------------------
 
-Board::Board() { reset(); }
+template <int Size>
+BasicBoard<Size>::BasicBoard() { reset(); }
 
-Cell Board::at(uint8_t x, uint8_t y) const
+template <int Size>
+Cell BasicBoard<Size>::at(uint8_t x, uint8_t y) const
 {
     if (!isInside(x, y))
         return Cell::Empty;
-    return cells[idx(x, y)];
+    return mail.at(idx(x, y));
 }
 
-void Board::reset()
+template <int Size>
+void BasicBoard<Size>::reset()
 {
-    cells.fill(Cell::Empty);
+    bb.clear();
+    packed.clear();
+    mail.clear();
     currentPlayer = Player::Black;
     blackPairs = whitePairs = 0;
     blackStones = whiteStones = 0;
     gameState = GameStatus::Ongoing;
     moveHistory.clear();
+    moveHistory.reserve(HISTORY_RESERVE);
     occupied_.clear();
     occIdx_.fill(-1);
+    stones_.clear();
+    frontier_.clear();
+    frontier_.reserve(N);
+    frontierIdx_.fill(-1);
+    nearStones_.fill(0);
+    forbiddenPlain_ = {};
+    forbiddenCapt_ = {};
+    staleThrees_.clear();
+    staleCaptures_.clear();
+    trail_.clear();
+    trail_.reserve(TRAIL_RESERVE);
+    captureDirs_ = {};
+    captureCells_ = {};
+    exposed_ = {};
+    exposedRefs_.fill(0);
+    exposedPairs_ = {};
 
     // Zobrist
-    zobristHash = 0ull;
-    // Encode le trait (Black to move)
-    zobristHash ^= Z_SIDE;
+    zobristSym = {};
+    // Encode le trait (Black to move) et les compteurs de captures (0/0)
+    toggleSideKey();
+    for (auto& k : zobristSym)
+        k ^= z_pairs<Size>(0, 0);
 }
 
 // ------------------------------------------------
 // Double-trois (free-threes) avec prise en compte des captures
-bool Board::createsIllegalDoubleThree(Move m, const RuleSet& rules) const
+template <int Size>
+template <RuleVariant V>
+bool BasicBoard<Size>::createsIllegalDoubleThree(Move m) const
 {
-    if (!rules.forbidDoubleThree)
+    if constexpr (!V.forbidDoubleThree)
         return false;
+    else
+        return doubleThreeMask<V>(m.by).test(idx(m.pos.x, m.pos.y));
+}
 
-    // Exception: un coup QUI CAPTURE est autorisé même s'il crée un double-trois
-    if (rules.capturesEnabled && wouldCapture(m))
-        return false;
+template <int Size>
+template <RuleVariant V>
+auto BasicBoard<Size>::doubleThreeMask(Player p) const -> const CellSet&
+{
+    static const CellSet NONE {};
+    refreshLines<V>();
+    const int ci = (p == Player::Black ? 0 : 1);
+    if constexpr (!V.forbidDoubleThree)
+        return NONE;
+    else if constexpr (V.captures)
+        return forbiddenCapt_[ci]; // Exception: un coup QUI CAPTURE est autorisé même s'il crée un double-trois
+    else
+        return forbiddenPlain_[ci];
+}
 
-    const Cell ME = playerToCell(m.by);
-    const Cell OP = (ME == Cell::Black ? Cell::White : Cell::Black);
-
-    // cases virtuellement retirées par capture causée par m
-    auto capturedVirt = [&](int x, int y) -> bool {
-        static constexpr int DX[4] = { 1, 0, 1, 1 };
-        static constexpr int DY[4] = { 0, 1, 1, -1 };
-        for (int d = 0; d < 4; ++d) {
-            // sens +
-            int x1 = m.pos.x + DX[d], y1 = m.pos.y + DY[d];
-            int x2 = m.pos.x + 2 * DX[d], y2 = m.pos.y + 2 * DY[d];
-            int x3 = m.pos.x + 3 * DX[d], y3 = m.pos.y + 3 * DY[d];
-            if (isInside(static_cast<uint8_t>(x3), static_cast<uint8_t>(y3)) && at(static_cast<uint8_t>(x1), static_cast<uint8_t>(y1)) == OP && at(static_cast<uint8_t>(x2), static_cast<uint8_t>(y2)) == OP && at(static_cast<uint8_t>(x3), static_cast<uint8_t>(y3)) == ME)
-                return (x == x1 && y == y1) || (x == x2 && y == y2);
-            // sens -
-            int X1 = m.pos.x - DX[d], Y1 = m.pos.y - DY[d];
-            int X2 = m.pos.x - 2 * DX[d], Y2 = m.pos.y - 2 * DY[d];
-            int X3 = m.pos.x - 3 * DX[d], Y3 = m.pos.y - 3 * DY[d];
-            if (isInside(static_cast<uint8_t>(X3), static_cast<uint8_t>(Y3)) && at(static_cast<uint8_t>(X1), static_cast<uint8_t>(Y1)) == OP && at(static_cast<uint8_t>(X2), static_cast<uint8_t>(Y2)) == OP && at(static_cast<uint8_t>(X3), static_cast<uint8_t>(Y3)) == ME)
-                return (x == X1 && y == Y1) || (x == X2 && y == Y2);
-        }
-        return false;
-    };
+template <int Size>
+auto BasicBoard<Size>::doubleThreeMask(Player p, const RuleSet& rules) const -> const CellSet&
+{
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() -> const CellSet& { return doubleThreeMask<V>(p); });
+}
 
-    auto vAt = [&](int x, int y) -> Cell {
-        if (x < 0 || y < 0 || x >= BOARD_SIZE || y >= BOARD_SIZE)
-            return OP; // mur = adversaire
-        if ((int)m.pos.x == x && (int)m.pos.y == y)
-            return ME;
-        if (capturedVirt(x, y))
-            return Cell::Empty;
-        return at(static_cast<uint8_t>(x), static_cast<uint8_t>(y));
-    };
+// Deux trois libres formés par 'me' en id (case vide); caps = captureDirs(id, me)
+template <int Size>
+bool BasicBoard<Size>::formsDoubleThree(uint16_t id, Cell me, uint8_t caps) const
+{
+    // cases virtuellement retirées par la première capture causée par m (±1, ±2 sur sa ligne)
+    int virtDir = -1;
+    uint32_t virtMask = 0;
+    if (caps) {
+        const int first = std::countr_zero(caps);
+        virtDir = first / 2;
+        virtMask = (first & 1) ? 0xF << (2 * 3) : 0xF << (2 * 6); // cases k=-2,-1 (sens -) ou k=+1,+2 (sens +)
+    }
 
-    auto hasThreeInLine = [&](int dx, int dy) -> bool {
-        std::string s;
-        s.reserve(11);
-        for (int k = -5; k <= 5; ++k) {
-            int x = (int)m.pos.x + k * dx;
-            int y = (int)m.pos.y + k * dy;
-            Cell c = vAt(x, y);
-            char ch = (c == Cell::Empty) ? '0' : (c == ME ? '1' : '2');
-            s.push_back(ch);
-        }
-        auto contains = [&](const std::string& pat) -> bool {
-            return s.find(pat) != std::string::npos;
-        };
-        if (contains("01110"))
-            return true; // 0 111 0
-        if (contains("010110"))
-            return true; // 0 1 0 11 0
-        if (contains("011010"))
-            return true; // 0 11 0 1 0
-        return false;
+    // Fenêtre packée de 11 cases autour de m, ramenée aux codes relatifs (1 = ME, 2 = OP)
+    auto hasThreeInLine = [&](int d) -> bool {
+        uint32_t w = packed.relativeWindow(d, id, me);
+        if (d == virtDir)
+            w &= ~virtMask;
+        return formsFreeThree(w);
     };
 
     int threes = 0;
-    if (hasThreeInLine(1, 0))
-        ++threes;
-    if (hasThreeInLine(0, 1))
-        ++threes;
-    if (hasThreeInLine(1, 1))
-        ++threes;
-    if (hasThreeInLine(1, -1))
-        ++threes;
+    for (int d = 0; d < Bitboard::DIRS; ++d)
+        if (hasThreeInLine(d) && ++threes >= 2)
+            return true;
+    return false;
+}
+
+// Réévalue les cases dont une fenêtre de ligne a changé depuis la dernière requête
+// (la portée ±5 couvre les motifs XOOX à ±3). Les anciennes valeurs modifiées vont
+// sur la piste, que undoMove restaure; sans coup à défaire, rien n'est noté.
+template <int Size>
+uint8_t BasicBoard<Size>::threeBits(uint16_t id) const
+{
+    uint8_t bits = 0;
+    for (int ci = 0; ci < 2; ++ci)
+        bits |= static_cast<uint8_t>((forbiddenPlain_[ci].test(id) ? 1u : 0u) << ci | (forbiddenCapt_[ci].test(id) ? 4u : 0u) << ci);
+    return bits;
+}
+
+template <int Size>
+void BasicBoard<Size>::refreshThrees() const
+{
+    staleThrees_.forEach([&](int id) {
+        const auto cell = static_cast<uint16_t>(id);
+        const bool empty = bb.at(cell) == Cell::Empty;
+        uint8_t threes = 0;
+        for (int ci = 0; ci < 2; ++ci) {
+            const Cell me = ci == 0 ? Cell::Black : Cell::White;
+            const uint8_t caps = empty ? packed.captureDirs(cell, me) : 0;
+            const bool three = empty && formsDoubleThree(cell, me, caps);
+            threes |= static_cast<uint8_t>((three ? 1u : 0u) << ci | (three && !caps ? 4u : 0u) << ci);
+        }
+        const uint8_t old = threeBits(cell);
+        if (threes == old)
+            return;
+        if (!moveHistory.empty())
+            trail_.push_back({ cell, old, { captureDirs_[0][cell], captureDirs_[1][cell] } });
+        for (int ci = 0; ci < 2; ++ci) {
+            forbiddenPlain_[ci].assign(cell, (threes >> ci) & 1u);
+            forbiddenCapt_[ci].assign(cell, (threes >> (2 + ci)) & 1u);
+        }
+    });
+    staleThrees_.clear();
+}
 
-    return threes >= 2;
+template <int Size>
+void BasicBoard<Size>::refreshCaptures() const
+{
+    staleCaptures_.forEach([&](int id) {
+        const auto cell = static_cast<uint16_t>(id);
+        const bool empty = bb.at(cell) == Cell::Empty;
+        const std::array<uint8_t, 2> dirs { empty ? packed.captureDirs(cell, Cell::Black) : uint8_t { 0 },
+            empty ? packed.captureDirs(cell, Cell::White) : uint8_t { 0 } };
+        const std::array<uint8_t, 2> old { captureDirs_[0][cell], captureDirs_[1][cell] };
+        if (dirs == old)
+            return;
+        if (!moveHistory.empty())
+            trail_.push_back({ cell, threeBits(cell), old });
+        for (int ci = 0; ci < 2; ++ci)
+            setCaptureDirs(cell, ci, dirs[ci]);
+    });
+    staleCaptures_.clear();
+}
+
+// Met à jour la case de capture et, par différence avec l'ancien masque, les paires exposées
+template <int Size>
+void BasicBoard<Size>::setCaptureDirs(uint16_t id, int capturer, uint8_t dirs) const
+{
+    const uint8_t old = captureDirs_[capturer][id];
+    if (old == dirs)
+        return;
+    captureDirs_[capturer][id] = dirs;
+    captureCells_[capturer].assign(id, dirs != 0);
+
+    const int victim = 1 - capturer;
+    exposedPairs_[victim] += std::popcount(dirs) - std::popcount(old);
+    for (uint8_t changed = old ^ dirs; changed; changed &= changed - 1) {
+        const int bit = std::countr_zero(changed);
+        const int step = (bit & 1) ? -Bitboard::STEP[bit / 2] : Bitboard::STEP[bit / 2];
+        const bool added = dirs & (1u << bit);
+        for (int k = 1; k <= 2; ++k) {
+            const auto stone = static_cast<uint16_t>(id + k * step);
+            if (added ? exposedRefs_[stone]++ == 0 : --exposedRefs_[stone] == 0)
+                exposed_[victim].assign(stone, added);
+        }
+    }
 }
 
 // ------------------------------------------------
 // Détecte 5+ alignés depuis p (8 directions)
-bool Board::checkFiveOrMoreFrom(Pos p, Cell who) const
-{
-    static constexpr int DX[4] = { 1, 0, 1, 1 };
-    static constexpr int DY[4] = { 0, 1, 1, -1 };
-    for (int d = 0; d < 4; ++d) {
-        int count = 1;
-        for (int s = -1; s <= 1; s += 2) {
-            int x = p.x, y = p.y;
-            while (true) {
-                x += s * DX[d];
-                y += s * DY[d];
-                if (!isInside(static_cast<uint8_t>(x), static_cast<uint8_t>(y)))
-                    break;
-                if (at(static_cast<uint8_t>(x), static_cast<uint8_t>(y)) == who)
-                    ++count;
-                else
-                    break;
-            }
-        }
-        if (count >= 5)
+template <int Size>
+bool BasicBoard<Size>::checkFiveOrMoreFrom(Pos p, Cell who) const
+{
+    const uint16_t id = idx(p.x, p.y);
+    for (int d = 0; d < Bitboard::DIRS; ++d) {
+        // un départ de 5 dans [bit-4, bit] couvre p
+        const auto sl = Bitboard::slot(d, id);
+        if ((Bitboard::fiveStarts(bb.line(who, d, id)) >> (sl.bit - 4)) & 0x1Fu)
             return true;
     }
     return false;
@@ -170,45 +303,47 @@ bool Board::checkFiveOrMoreFrom(Pos p, Cell who) const
 
 // ------------------------------------------------
 // Captures XOOX dans 4 directions et 2 sens
-int Board::applyCapturesAround(Pos p, Cell who, const RuleSet& rules, std::vector<Pos>& removed)
+template <int Size>
+template <RuleVariant V>
+int BasicBoard<Size>::applyCapturesAround(uint16_t id, Cell who, uint8_t dirs, UndoEntry& u)
 {
-    if (!rules.capturesEnabled)
+    if constexpr (!V.captures)
         return 0;
 
-    static constexpr int DX[4] = { 1, 0, 1, 1 };
-    static constexpr int DY[4] = { 0, 1, 1, -1 };
-
     const Cell opp = (who == Cell::Black ? Cell::White : Cell::Black);
     int pairs = 0;
 
-    auto tryDir = [&](int sx, int sy, int dx, int dy) -> bool {
-        int x1 = sx + dx, y1 = sy + dy;
-        int x2 = sx + 2 * dx, y2 = sy + 2 * dy;
-        int x3 = sx + 3 * dx, y3 = sy + 3 * dy;
-        if (!isInside(static_cast<uint8_t>(x3), static_cast<uint8_t>(y3)))
-            return false;
-        if (at(static_cast<uint8_t>(x1), static_cast<uint8_t>(y1)) == opp && at(static_cast<uint8_t>(x2), static_cast<uint8_t>(y2)) == opp && at(static_cast<uint8_t>(x3), static_cast<uint8_t>(y3)) == who) {
-            cells[idx(static_cast<uint8_t>(x1), static_cast<uint8_t>(y1))] = Cell::Empty;
-            cells[idx(static_cast<uint8_t>(x2), static_cast<uint8_t>(y2))] = Cell::Empty;
-            removed.push_back({ (uint8_t)x1, (uint8_t)y1 });
-            removed.push_back({ (uint8_t)x2, (uint8_t)y2 });
-            return true;
+    for (int d = 0; d < Bitboard::DIRS; ++d) {
+        for (int sign = 0; sign < 2; ++sign) {
+            if (!(dirs & (1u << (2 * d + sign))))
+                continue;
+            const int step = sign ? -Bitboard::STEP[d] : Bitboard::STEP[d];
+            const auto i1 = static_cast<uint16_t>(id + step);
+            const auto i2 = static_cast<uint16_t>(id + 2 * step);
+            takeStone(i1, opp);
+            takeStone(i2, opp);
+            u.capturedStones[u.capturedCount++] = posOf(i1);
+            u.capturedStones[u.capturedCount++] = posOf(i2);
+            ++pairs;
         }
-        return false;
-    };
-
-    for (int d = 0; d < 4; ++d) {
-        if (tryDir(p.x, p.y, DX[d], DY[d]))
-            ++pairs; // sens +
-        if (tryDir(p.x, p.y, -DX[d], -DY[d]))
-            ++pairs; // sens -
     }
     return pairs;
 }
 
 // ------------------------------------------------
-PlayResult Board::applyCore(Move m, const RuleSet& rules, bool record)
+template <int Size>
+PlayResult BasicBoard<Size>::checkMove(Move m, const RuleSet& rules) const
 {
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() { return checkMoveFor<V>(m, rules); });
+}
+
+template <int Size>
+template <RuleVariant V>
+PlayResult BasicBoard<Size>::checkMoveFor(Move m, const RuleSet& rules) const
+{
+    if (!isInside(m.pos.x, m.pos.y)) {
+        return PlayResult::fail(PlayErrorCode::InvalidPosition, "Invalid position.");
+    }
     if (gameState != GameStatus::Ongoing) {
         return PlayResult::fail(PlayErrorCode::GameFinished, "Game already finished.");
     }
@@ -220,10 +355,10 @@ PlayResult Board::applyCore(Move m, const RuleSet& rules, bool record)
     }
 
     bool mustBreak = false;
-    if (rules.allowFiveOrMore && rules.capturesEnabled) {
+    if constexpr (V.alignWins && V.captures) {
         Player justPlayed = opponent(currentPlayer);
         Cell meC = playerToCell(justPlayed);
-        if (hasAnyFive(meC) && isFiveBreakableNow(justPlayed, rules))
+        if (hasAnyFive(meC) && isFiveBreakableNow<V>(justPlayed, rules))
             mustBreak = true;
     }
 
@@ -232,95 +367,70 @@ PlayResult Board::applyCore(Move m, const RuleSet& rules, bool record)
         if (!wouldCapture(m)) {
             return PlayResult::fail(PlayErrorCode::RuleViolation, "Must break opponent's five.");
         }
-        Board sim = *this;
-        sim.cells[idx(m.pos.x, m.pos.y)] = playerToCell(m.by);
-        std::vector<Pos> removedTmp;
-        int gainedTmp = sim.applyCapturesAround(m.pos, playerToCell(m.by), rules, removedTmp);
-        if (gainedTmp) {
-            if (m.by == Player::Black)
-                sim.blackPairs += gainedTmp;
-            else
-                sim.whitePairs += gainedTmp;
-        }
-        int myPairsAfter = (m.by == Player::Black ? sim.blackPairs : sim.whitePairs);
-        Cell oppFiveColor = playerToCell(opponent(currentPlayer));
-        bool breaks = (myPairsAfter >= rules.captureWinPairs) || (!sim.hasAnyFive(oppFiveColor));
+        const int myPairs = (m.by == Player::Black ? blackPairs : whitePairs);
+        bool breaks = captureBreaksFive<V>(idx(m.pos.x, m.pos.y), playerToCell(m.by), myPairs, rules);
         if (!breaks) {
             return PlayResult::fail(PlayErrorCode::RuleViolation, "Must break opponent's five.");
         }
         allowDoubleThreeThisMove = true;
     }
 
-    if (!allowDoubleThreeThisMove && createsIllegalDoubleThree(m, rules)) {
+    if (!allowDoubleThreeThisMove && createsIllegalDoubleThree<V>(m)) {
         return PlayResult::fail(PlayErrorCode::RuleViolation, "Illegal double-three.");
     }
 
-    // Préparation Undo (si record)
-    UndoEntry u;
-    if (record) {
-        u.move = m;
-        u.blackPairsBefore = blackPairs;
-        u.whitePairsBefore = whitePairs;
-        u.blackStonesBefore = blackStones;
-        u.whiteStonesBefore = whiteStones;
-        u.stateBefore = gameState;
-        u.playerBefore = currentPlayer;
-    }
+    return PlayResult::ok();
+}
 
-    cells[idx(m.pos.x, m.pos.y)] = playerToCell(m.by);
-    zobristHash ^= z_of(playerToCell(m.by), m.pos.x, m.pos.y);
-    // Track stone counts
-    if (m.by == Player::Black)
-        ++blackStones;
-    else
-        ++whiteStones;
-    // Sparse index add
-    {
-        const int id = idx(m.pos.x, m.pos.y);
-        occIdx_[id] = static_cast<int16_t>(occupied_.size());
-        occupied_.push_back(m.pos);
-    }
+template <int Size>
+template <RuleVariant V>
+PlayResult BasicBoard<Size>::applyCore(Move m, const RuleSet& rules, bool record)
+{
+    PlayResult pr = checkMoveFor<V>(m, rules);
+    if (pr.success)
+        applyUnchecked<V>(m, rules, record);
+    return pr;
+}
 
-    std::vector<Pos> capturedLocal; // utilisera u.capturedStones si record
-    auto& capVec = record ? u.capturedStones : capturedLocal;
-    int gained = applyCapturesAround(m.pos, playerToCell(m.by), rules, capVec);
+template <int Size>
+template <RuleVariant V>
+void BasicBoard<Size>::applyUnchecked(Move m, const RuleSet& rules, bool record)
+{
+    // Préparation Undo (entrée de taille fixe, sans allocation)
+    UndoEntry u;
+    u.move = m;
+    u.blackPairsBefore = blackPairs;
+    u.whitePairsBefore = whitePairs;
+    u.blackStonesBefore = blackStones;
+    u.whiteStonesBefore = whiteStones;
+    u.stateBefore = gameState;
+    u.playerBefore = currentPlayer;
+    u.staleThreesBefore = staleThrees_;
+    u.staleCapturesBefore = staleCaptures_;
+    u.trailBefore = static_cast<uint32_t>(trail_.size());
+
+    const uint16_t id = idx(m.pos.x, m.pos.y);
+    const Cell who = playerToCell(m.by);
+    // Lu sur les lignes packées: l'index de captures peut attendre la prochaine requête
+    const uint8_t dirs = V.captures ? packed.captureDirs(id, who) : 0;
+    putStone(id, who);
+
+    // Les captures retirent les pierres (bitboards, zobrist, compteurs, index creux)
+    int gained = applyCapturesAround<V>(id, who, dirs, u);
     if (gained) {
         if (m.by == Player::Black)
-            blackPairs += gained;
+            setPairs(blackPairs + gained, whitePairs);
         else
-            whitePairs += gained;
-        Cell oppC = (m.by == Player::Black ? Cell::White : Cell::Black);
-        for (auto rp : capVec) {
-            zobristHash ^= z_of(oppC, rp.x, rp.y);
-            // Decrement opponent stone counts for captured stones
-            if (oppC == Cell::Black)
-                --blackStones;
-            else
-                --whiteStones;
-            // Sparse index remove via swap-pop
-            const int id = idx(rp.x, rp.y);
-            int16_t posIdx = occIdx_[id];
-            if (posIdx >= 0) {
-                const int lastIdx = static_cast<int>(occupied_.size()) - 1;
-                if (posIdx != lastIdx) {
-                    Pos moved = occupied_.back();
-                    occupied_[posIdx] = moved;
-                    occIdx_[moved.toIndex()] = posIdx;
-                }
-                occupied_.pop_back();
-                occIdx_[id] = -1;
-            }
-        }
+            setPairs(blackPairs, whitePairs + gained);
     }
 
-    if (rules.allowFiveOrMore && checkFiveOrMoreFrom(m.pos, playerToCell(m.by))) {
-        if (!isFiveBreakableNow(m.by, rules)) {
+    if constexpr (V.alignWins) {
+        if (checkFiveOrMoreFrom(m.pos, playerToCell(m.by)) && !isFiveBreakableNow<V>(m.by, rules))
             gameState = GameStatus::WinByAlign;
-        }
     }
 
-    if (rules.capturesEnabled && gameState == GameStatus::Ongoing) {
-        if (blackPairs >= rules.captureWinPairs || whitePairs >= rules.captureWinPairs)
+    if constexpr (V.captures) {
+        if (gameState == GameStatus::Ongoing && (blackPairs >= rules.captureWinPairs || whitePairs >= rules.captureWinPairs))
             gameState = GameStatus::WinByCapture;
     }
 
@@ -328,346 +438,407 @@ PlayResult Board::applyCore(Move m, const RuleSet& rules, bool record)
         gameState = GameStatus::Draw;
 
     if (record) {
-        moveHistory.push_back(std::move(u));
+        moveHistory.push_back(u);
     }
     currentPlayer = opponent(currentPlayer);
-    zobristHash ^= Z_SIDE;
-
-    return PlayResult::ok();
+    toggleSideKey();
 }
 
-PlayResult Board::tryPlay(Move m, const RuleSet& rules)
+template <int Size>
+PlayResult BasicBoard<Size>::tryPlay(Move m, const RuleSet& rules)
 {
-    return applyCore(m, rules, true);
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() { return tryPlayFor<V>(m, rules); });
 }
 
-bool Board::speculativeTry(Move m, const RuleSet& rules, PlayResult* out)
+template <int Size>
+template <RuleVariant V>
+PlayResult BasicBoard<Size>::tryPlayFor(Move m, const RuleSet& rules)
 {
-    // Implémentation Option B (diff ciblé) :
-    // On enregistre uniquement l'état minimal nécessaire pour restaurer :
-    // - hash, joueur courant, compteurs captures, statut
-    // - contenu des cellules susceptibles de changer (la case jouée + jusqu'à 8*2 candidates captures)
+    return applyCore<V>(m, rules, true);
+}
 
-    uint64_t hashBefore = zobristHash;
-    Player playerBefore = currentPlayer;
-    int blackPairsBefore = blackPairs;
-    int whitePairsBefore = whitePairs;
-    int blackStonesBefore = blackStones;
-    int whiteStonesBefore = whiteStones;
-    GameStatus statusBefore = gameState;
+template <int Size>
+void BasicBoard<Size>::doMove(Move m, const RuleSet& rules)
+{
+    withRuleVariant(rules.variant(), [&]<RuleVariant V>() { doMoveFor<V>(m, rules); });
+}
 
-    struct CellSnapshot {
-        Pos p;
-        Cell before;
-    };
-    CellSnapshot center { m.pos, at(m.pos.x, m.pos.y) }; // devrait être Empty si légal
-
-    // Générer les positions candidates pouvant être capturées (x1,x2) pour chaque direction ±
-    static constexpr int DX[4] = { 1, 0, 1, 1 };
-    static constexpr int DY[4] = { 0, 1, 1, -1 };
-    CellSnapshot candidates[16];
-    int candCount = 0;
-    bool seen[BOARD_SIZE * BOARD_SIZE] = { false };
-    auto mark = [&](int x, int y) {
-        if (!isInside(static_cast<uint8_t>(x), static_cast<uint8_t>(y)))
-            return;
-        int idFlat = y * BOARD_SIZE + x;
-        if (seen[idFlat])
-            return;
-        seen[idFlat] = true;
-        candidates[candCount++] = CellSnapshot { Pos { (uint8_t)x, (uint8_t)y }, at(static_cast<uint8_t>(x), static_cast<uint8_t>(y)) };
-    };
-    for (int d = 0; d < 4; ++d) {
-        int x1 = m.pos.x + DX[d], y1 = m.pos.y + DY[d];
-        int x2 = m.pos.x + 2 * DX[d], y2 = m.pos.y + 2 * DY[d];
-        mark(x1, y1);
-        mark(x2, y2);
-        int X1 = m.pos.x - DX[d], Y1 = m.pos.y - DY[d];
-        int X2 = m.pos.x - 2 * DX[d], Y2 = m.pos.y - 2 * DY[d];
-        mark(X1, Y1);
-        mark(X2, Y2);
-    }
+template <int Size>
+template <RuleVariant V>
+void BasicBoard<Size>::doMoveFor(Move m, const RuleSet& rules)
+{
+    assert(m.by == currentPlayer && isEmpty(m.pos.x, m.pos.y) && gameState == GameStatus::Ongoing);
+    applyUnchecked<V>(m, rules, true);
+}
 
-    PlayResult pr = applyCore(m, rules, false);
+template <int Size>
+bool BasicBoard<Size>::speculativeTry(Move m, const RuleSet& rules, PlayResult* out) const
+{
+    // Les règles sont évaluées sans poser la pierre: aucun état à restaurer.
+    PlayResult pr = checkMove(m, rules);
+    const bool ok = pr.success;
     if (out)
-        *out = pr;
-    if (!pr.success) {
-        // Aucune mutation durable si échec (toutes les validations échouantes précèdent la pose).
-        return false;
-    }
-
-    // ROLLBACK : retirer la pierre posée et restaurer les cellules capturées.
-    // La pierre jouée est toujours à m.pos si succès.
-    cells[idx(m.pos.x, m.pos.y)] = center.before; // normalement Empty
-    // adjust stone counts for the removed placed stone
-    if (m.by == Player::Black)
-        --blackStones;
-    else
-        --whiteStones;
-
-    // Restaurer chaque cellule candidate devenue vide alors qu'elle ne l'était pas avant
-    for (int i = 0; i < candCount; ++i) {
-        auto& snap = candidates[i];
-        Cell after = at(snap.p.x, snap.p.y);
-        // Si la cellule a été vidée (capture) on la restaure.
-        if (snap.before != Cell::Empty && after == Cell::Empty) {
-            // (snap.before devrait être oppC en pratique)
-            cells[idx(snap.p.x, snap.p.y)] = snap.before;
-            if (snap.before == Cell::Black)
-                ++blackStones;
-            else if (snap.before == Cell::White)
-                ++whiteStones;
-        }
-    }
-
-    // Restaurer compteurs & statut & trait & hash
-    blackPairs = blackPairsBefore;
-    whitePairs = whitePairsBefore;
-    blackStones = blackStonesBefore;
-    whiteStones = whiteStonesBefore;
-    gameState = statusBefore;
-    currentPlayer = playerBefore;
-    zobristHash = hashBefore; // hash global cohérent (inclut side to move)
-
-    return true;
+        *out = std::move(pr);
+    return ok;
 }
 
 // ------------------------------------------------
-bool Board::undo()
+template <int Size>
+bool BasicBoard<Size>::undo()
 {
     if (moveHistory.empty())
         return false;
-    UndoEntry u = std::move(moveHistory.back());
-    moveHistory.pop_back();
+    undoMove();
+    return true;
+}
+
+template <int Size>
+void BasicBoard<Size>::undoMove()
+{
+    assert(!moveHistory.empty());
+    const UndoEntry& u = moveHistory.back();
 
     // Zobrist: le trait redevient celui d'avant
-    zobristHash ^= Z_SIDE;
-
-    // Retirer la pierre jouée
-    cells[idx(u.move.pos.x, u.move.pos.y)] = Cell::Empty;
-    // Zobrist: retirer la pierre annulée
-    zobristHash ^= z_of(playerToCell(u.move.by), u.move.pos.x, u.move.pos.y);
-    // Update stone count for removed stone
-    if (u.move.by == Player::Black)
-        --blackStones;
-    else
-        --whiteStones;
-    // Sparse index remove via swap-pop
-    {
-        const int id = idx(u.move.pos.x, u.move.pos.y);
-        int16_t posIdx = occIdx_[id];
-        if (posIdx >= 0) {
-            const int lastIdx = static_cast<int>(occupied_.size()) - 1;
-            if (posIdx != lastIdx) {
-                Pos moved = occupied_.back();
-                occupied_[posIdx] = moved;
-                occIdx_[moved.toIndex()] = posIdx;
-            }
-            occupied_.pop_back();
-            occIdx_[id] = -1;
-        }
-    }
+    toggleSideKey();
+
+    // Retirer la pierre jouée (bitboards, zobrist, compteurs, index creux)
+    takeStone(idx(u.move.pos.x, u.move.pos.y), playerToCell(u.move.by));
 
     // Restaurer les pierres capturées
     Cell oppC = (u.move.by == Player::Black ? Cell::White : Cell::Black);
-    for (auto rp : u.capturedStones) {
-        cells[idx(rp.x, rp.y)] = oppC;
-        // Zobrist: remettre les capturées
-        zobristHash ^= z_of(oppC, rp.x, rp.y);
-        if (oppC == Cell::Black)
-            ++blackStones;
-        else
-            ++whiteStones;
-        // Sparse index add back
-        const int id = idx(rp.x, rp.y);
-        occIdx_[id] = static_cast<int16_t>(occupied_.size());
-        occupied_.push_back(rp);
-    }
-    blackPairs = u.blackPairsBefore;
-    whitePairs = u.whitePairsBefore;
+    for (int i = 0; i < u.capturedCount; ++i)
+        putStone(idx(u.capturedStones[i].x, u.capturedStones[i].y), oppC);
+    setPairs(u.blackPairsBefore, u.whitePairsBefore);
     blackStones = u.blackStonesBefore;
     whiteStones = u.whiteStonesBefore;
     gameState = u.stateBefore;
     currentPlayer = u.playerBefore;
-    return true;
+
+    // Caches de lignes: les entrées réécrites depuis le coup reprennent leur valeur,
+    // et les cases périmées avant le coup le redeviennent
+    while (trail_.size() > u.trailBefore) {
+        const TrailEntry& t = trail_.back();
+        for (int ci = 0; ci < 2; ++ci) {
+            forbiddenPlain_[ci].assign(t.id, (t.threes >> ci) & 1u);
+            forbiddenCapt_[ci].assign(t.id, (t.threes >> (2 + ci)) & 1u);
+            setCaptureDirs(t.id, ci, t.dirs[ci]);
+        }
+        trail_.pop_back();
+    }
+    staleThrees_ = u.staleThreesBefore;
+    staleCaptures_ = u.staleCapturesBefore;
+    moveHistory.pop_back();
 }
 
 // ------------------------------------------------
-std::vector<Move> Board::legalMoves(Player p, const RuleSet& rules) const
+template <int Size>
+auto BasicBoard<Size>::legalMask(Player p, const RuleSet& rules) const -> CellSet
 {
-    std::vector<Move> out;
-    // If the board is empty (no moves yet), fall back to scanning for all empties
-    // to preserve initial-move behavior.
-    if (moveHistory.empty()) {
-        out.reserve(BOARD_SIZE * BOARD_SIZE);
-        for (uint8_t y = 0; y < BOARD_SIZE; ++y) {
-            for (uint8_t x = 0; x < BOARD_SIZE; ++x) {
-                if (at(x, y) != Cell::Empty)
-                    continue;
-                Move m { { x, y }, p };
-                if (createsIllegalDoubleThree(m, rules))
-                    continue;
-                out.push_back(m);
-            }
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() { return legalMaskFor<V>(p, rules); });
+}
+
+template <int Size>
+template <RuleVariant V>
+auto BasicBoard<Size>::legalMaskFor(Player p, const RuleSet& rules) const -> CellSet
+{
+    CellSet mask;
+    if (gameState != GameStatus::Ongoing)
+        return mask;
+
+    // 5+ adverse cassable: seules les captures qui le cassent sont jouables (double-trois permis)
+    if constexpr (V.alignWins && V.captures) {
+        const Player justPlayed = opponent(p);
+        if (hasAnyFive(playerToCell(justPlayed))) {
+            mask = fiveBreakers<V>(justPlayed, rules, false);
+            if (mask.any())
+                return mask;
         }
-        return out;
     }
 
-    // Otherwise, restrict to empties within Chebyshev distance <= 2 of any occupied cell
-    // using the sparse occupied index to avoid scanning the whole board.
-    std::vector<uint8_t> mark(static_cast<std::size_t>(BOARD_SIZE * BOARD_SIZE), 0);
-    out.reserve(256);
-    for (const auto& s : occupied_) {
-        for (int dy = -2; dy <= 2; ++dy) {
-            for (int dx = -2; dx <= 2; ++dx) {
-                int nx = static_cast<int>(s.x) + dx;
-                int ny = static_cast<int>(s.y) + dy;
-                if (!isInside(static_cast<uint8_t>(nx), static_cast<uint8_t>(ny)))
-                    continue;
-                if (at(static_cast<uint8_t>(nx), static_cast<uint8_t>(ny)) != Cell::Empty)
-                    continue;
-                uint16_t id = idx(static_cast<uint8_t>(nx), static_cast<uint8_t>(ny));
-                if (mark[id])
-                    continue;
-                mark[id] = 1;
-                Move m { { static_cast<uint8_t>(nx), static_cast<uint8_t>(ny) }, p };
-                if (createsIllegalDoubleThree(m, rules))
-                    continue;
-                out.push_back(m);
-            }
-        }
+    mask = CellSet::all();
+    mask.subtract(stones_);
+    if constexpr (V.forbidDoubleThree)
+        mask.subtract(doubleThreeMask<V>(p));
+    return mask;
+}
+
+template <int Size>
+std::vector<Move> BasicBoard<Size>::legalMoves(Player p, const RuleSet& rules) const
+{
+    MoveList list;
+    legalMoves(p, rules, list);
+    return list.toMoves(p);
+}
+
+template <int Size>
+void BasicBoard<Size>::legalMoves(Player p, const RuleSet& rules, MoveList& out) const
+{
+    withRuleVariant(rules.variant(), [&]<RuleVariant V>() { legalMovesFor<V>(p, rules, out); });
+}
+
+template <int Size>
+template <RuleVariant V>
+void BasicBoard<Size>::legalMovesFor(Player p, const RuleSet& rules, MoveList& out) const
+{
+    out.clear();
+    const CellSet legal = legalMaskFor<V>(p, rules);
+    // If the board is empty (no stones yet), every legal cell is returned
+    // to preserve initial-move behavior.
+    if (occupied_.empty()) {
+        legal.forEach([&](int id) { out.push_back(posOf(static_cast<uint16_t>(id))); });
+        return;
+    }
+
+    // Otherwise, legal empties within Chebyshev distance <= 2 of any stone: the frontier set.
+    for (const auto& f : frontier_) {
+        if (legal.test(idx(f.x, f.y)))
+            out.push_back(f);
     }
-    return out;
 }
 
 // ------------------------------------------------
-bool Board::hasAnyFive(Cell who) const
+template <int Size>
+bool BasicBoard<Size>::hasAnyFive(Cell who) const
+{
+    // Suivi incrémental par les bitboards (lignes contenant 5 bits consécutifs)
+    return bb.hasFive(who);
+}
+
+// 'capturer' jouant en id casse-t-il le 5+ adverse ? Les paires prises sont soustraites
+// des mots de ligne concernés, sans toucher au Board (requête en lecture seule).
+template <int Size>
+template <RuleVariant V>
+bool BasicBoard<Size>::captureBreaksFive(uint16_t id, Cell capturer, int capturerPairs, const RuleSet& rules) const
 {
-    // Iterate only on occupied cells to avoid scanning empty space
-    for (const auto& p : occupied_) {
-        if (at(p.x, p.y) == who) {
-            if (checkFiveOrMoreFrom(p, who))
-                return true;
+    if constexpr (!V.captures)
+        return false;
+    const uint8_t dirs = captureDirs(id, capturer);
+    if (!dirs)
+        return false;
+    if (capturerPairs + std::popcount(dirs) >= rules.captureWinPairs)
+        return true; // victoire immédiate par captures
+
+    const Cell victim = (capturer == Cell::Black ? Cell::White : Cell::Black);
+    std::array<uint16_t, MAX_CAPTURED> taken;
+    int n = 0;
+    for (int d = 0; d < Bitboard::DIRS; ++d) {
+        for (int sign = 0; sign < 2; ++sign) {
+            if (!(dirs & (1u << (2 * d + sign))))
+                continue;
+            const int step = sign ? -Bitboard::STEP[d] : Bitboard::STEP[d];
+            taken[n++] = static_cast<uint16_t>(id + step);
+            taken[n++] = static_cast<uint16_t>(id + 2 * step);
         }
     }
-    return false;
+    return !bb.hasFiveWithout(victim, taken.data(), n);
 }
 
 // Après que 'justPlayed' a posé sa pierre et que les captures ont été appliquées,
 // vérifier si l'adversaire peut casser immédiatement le 5+ par capture
-bool Board::isFiveBreakableNow(Player justPlayed, const RuleSet& rules) const
+template <int Size>
+template <RuleVariant V>
+bool BasicBoard<Size>::isFiveBreakableNow(Player justPlayed, const RuleSet& rules) const
 {
-    if (!rules.capturesEnabled)
-        return false;
+    return fiveBreakers<V>(justPlayed, rules, true).any();
+}
 
-    Player opp = (justPlayed == Player::Black ? Player::White : Player::Black);
-    Cell meC = playerToCell(justPlayed);
-
-    Board base = *this;
-    base.forceSide(opp); // au trait pour l'adversaire dans la simulation
-
-    // Build candidate empties adjacent (in the 4 aligned directions) to justPlayed's stones.
-    // Any XOOX capture square is adjacent to at least one of the two opponent stones (here: meC),
-    // so this neighborhood covers all immediate capture-breaking moves.
-    static constexpr int DX[4] = { 1, 0, 1, 1 };
-    static constexpr int DY[4] = { 0, 1, 1, -1 };
-    std::vector<uint8_t> seen(static_cast<std::size_t>(BOARD_SIZE * BOARD_SIZE), 0);
-    std::vector<Pos> cand;
-    cand.reserve(128);
-    for (const auto& s : base.occupied_) {
-        if (base.at(s.x, s.y) != meC)
-            continue;
-        for (int d = 0; d < 4; ++d) {
-            // + direction
-            int nx1 = static_cast<int>(s.x) + DX[d];
-            int ny1 = static_cast<int>(s.y) + DY[d];
-            if (base.isInside(static_cast<uint8_t>(nx1), static_cast<uint8_t>(ny1)) && base.at(static_cast<uint8_t>(nx1), static_cast<uint8_t>(ny1)) == Cell::Empty) {
-                uint16_t id = idx(static_cast<uint8_t>(nx1), static_cast<uint8_t>(ny1));
-                if (!seen[id]) {
-                    seen[id] = 1;
-                    cand.push_back(Pos { static_cast<uint8_t>(nx1), static_cast<uint8_t>(ny1) });
-                }
-            }
-            // - direction
-            int nx2 = static_cast<int>(s.x) - DX[d];
-            int ny2 = static_cast<int>(s.y) - DY[d];
-            if (base.isInside(static_cast<uint8_t>(nx2), static_cast<uint8_t>(ny2)) && base.at(static_cast<uint8_t>(nx2), static_cast<uint8_t>(ny2)) == Cell::Empty) {
-                uint16_t id = idx(static_cast<uint8_t>(nx2), static_cast<uint8_t>(ny2));
-                if (!seen[id]) {
-                    seen[id] = 1;
-                    cand.push_back(Pos { static_cast<uint8_t>(nx2), static_cast<uint8_t>(ny2) });
-                }
-            }
-        }
-    }
+template <int Size>
+template <RuleVariant V>
+auto BasicBoard<Size>::fiveBreakers(Player justPlayed, const RuleSet& rules, bool firstOnly) const -> CellSet
+{
+    CellSet out;
+    if constexpr (!V.captures)
+        return out;
 
-    for (const auto& pos : cand) {
-        Move mv { pos, opp };
-        if (!base.wouldCapture(mv))
-            continue; // only capturing moves can break immediately
-
-        Board sim = base;
-        // place the stone and apply captures
-        sim.cells[idx(mv.pos.x, mv.pos.y)] = playerToCell(opp);
-        std::vector<Pos> removed;
-        int gained = sim.applyCapturesAround(mv.pos, playerToCell(opp), rules, removed);
-        if (gained) {
-            if (opp == Player::Black)
-                sim.blackPairs += gained;
-            else
-                sim.whitePairs += gained;
-        }
+    const Player opp = opponent(justPlayed);
+    const Cell oppC = playerToCell(opp);
+    const int oppPairs = (opp == Player::Black ? blackPairs : whitePairs);
+    refreshLines<CAPTURE_INDEX>();
 
-        int oppPairsAfter = (opp == Player::Black ? sim.blackPairs : sim.whitePairs);
-        if (oppPairsAfter >= rules.captureWinPairs)
-            return true; // immediate win by capture
-        if (!sim.hasAnyFive(meC))
-            return true; // line is broken by the capture
-    }
-    return false;
+    // Seules les cases de capture de l'adversaire (index tenu à jour) peuvent casser le 5+
+    captureCells_[colorIndex(opp)].anyOf([&](int id) {
+        if (!captureBreaksFive<V>(static_cast<uint16_t>(id), oppC, oppPairs, rules))
+            return false;
+        out.set(id);
+        return firstOnly;
+    });
+    return out;
 }
 
-void Board::forceSide(Player p)
+template <int Size>
+void BasicBoard<Size>::forceSide(Player p)
 {
     if (currentPlayer != p) {
         currentPlayer = p;
         // Maintenir la clé Zobrist alignée avec "side to move"
-        zobristHash ^= Z_SIDE;
+        toggleSideKey();
     }
 }
 
-bool Board::isBoardFull() const
+template <int Size>
+bool BasicBoard<Size>::isBoardFull() const
 {
-    for (const auto& c : cells)
-        if (c == Cell::Empty)
-            return false;
-    return true;
+    return blackStones + whiteStones == N;
 }
 
 // Détecte si m provoquerait une capture XOOX (±4 directions)
-bool Board::wouldCapture(Move m) const
+template <int Size>
+bool BasicBoard<Size>::wouldCapture(Move m) const
 {
-    const Cell me = playerToCell(m.by);
-    const Cell opp = (me == Cell::Black ? Cell::White : Cell::Black);
-    static constexpr int DX[4] = { 1, 0, 1, 1 };
-    static constexpr int DY[4] = { 0, 1, 1, -1 };
+    return captureDirs(idx(m.pos.x, m.pos.y), playerToCell(m.by)) != 0;
+}
 
-    auto inside = [&](int X, int Y) { return 0 <= X && X < BOARD_SIZE && 0 <= Y && Y < BOARD_SIZE; };
+template <int Size>
+uint8_t BasicBoard<Size>::captureDirs(uint16_t id, Cell who) const
+{
+    refreshLines<CAPTURE_INDEX>();
+    return captureDirs_[who == Cell::Black ? 0 : 1][id];
+}
 
-    for (int d = 0; d < 4; ++d) {
-        int x1 = m.pos.x + DX[d], y1 = m.pos.y + DY[d];
-        int x2 = m.pos.x + 2 * DX[d], y2 = m.pos.y + 2 * DY[d];
-        int x3 = m.pos.x + 3 * DX[d], y3 = m.pos.y + 3 * DY[d];
-        if (inside(x1, y1) && inside(x2, y2) && inside(x3, y3) && at(static_cast<uint8_t>(x1), static_cast<uint8_t>(y1)) == opp && at(static_cast<uint8_t>(x2), static_cast<uint8_t>(y2)) == opp && at(static_cast<uint8_t>(x3), static_cast<uint8_t>(y3)) == me)
-            return true;
+// ------------------------------------------------
+// Zobrist: les 8 clés de symétrie évoluent ensemble
+template <int Size>
+void BasicBoard<Size>::toggleSideKey()
+{
+    for (auto& k : zobristSym)
+        k ^= ZOBRIST<Size>.side;
+}
 
-        int X1 = m.pos.x - DX[d], Y1 = m.pos.y - DY[d];
-        int X2 = m.pos.x - 2 * DX[d], Y2 = m.pos.y - 2 * DY[d];
-        int X3 = m.pos.x - 3 * DX[d], Y3 = m.pos.y - 3 * DY[d];
-        if (inside(X1, Y1) && inside(X2, Y2) && inside(X3, Y3) && at(static_cast<uint8_t>(X1), static_cast<uint8_t>(Y1)) == opp && at(static_cast<uint8_t>(X2), static_cast<uint8_t>(Y2)) == opp && at(static_cast<uint8_t>(X3), static_cast<uint8_t>(Y3)) == me)
-            return true;
+template <int Size>
+void BasicBoard<Size>::setPairs(int black, int white)
+{
+    const uint64_t delta = z_pairs<Size>(blackPairs, whitePairs) ^ z_pairs<Size>(black, white);
+    for (auto& k : zobristSym)
+        k ^= delta;
+    blackPairs = black;
+    whitePairs = white;
+}
+
+template <int Size>
+void BasicBoard<Size>::toggleStoneKey(Cell c, uint16_t id)
+{
+    for (int t = 0; t < SYMMETRIES; ++t)
+        zobristSym[t] ^= z_of<Size>(c, SYM_INDEX<Size>[t][id]);
+}
+
+// ------------------------------------------------
+// Pose / retrait élémentaires: seule porte d'entrée vers les bitboards
+template <int Size>
+void BasicBoard<Size>::putStone(uint16_t id, Cell c)
+{
+    bb.set(c, id);
+    packed.set(c, id);
+    mail.set(c, id);
+    const Pos p = posOf(id);
+    toggleStoneKey(c, id);
+    if (c == Cell::Black)
+        ++blackStones;
+    else
+        ++whiteStones;
+    occIdx_[id] = static_cast<int16_t>(occupied_.size());
+    occupied_.push_back(p);
+    stones_.set(id);
+    staleThrees_ |= LINE_REACH<Size>[id];
+    staleCaptures_ |= LINE_REACH<Size>[id];
+
+    // Frontière: la case quitte l'ensemble, ses voisines (5x5) y entrent au premier voisin
+    frontierRemove(id);
+    ++nearStones_[id];
+    const auto& box = Mailbox::box(id);
+    for (int i = 0, n = Mailbox::boxCount(id); i < n; ++i) {
+        const uint16_t nb = box[i];
+        if (nearStones_[nb]++ == 0 && mail.at(nb) == Cell::Empty)
+            frontierAdd(nb);
     }
-    return false;
 }
 
+template <int Size>
+void BasicBoard<Size>::takeStone(uint16_t id, Cell c)
+{
+    bb.reset(c, id);
+    packed.reset(id);
+    mail.reset(id);
+    toggleStoneKey(c, id);
+    staleThrees_ |= LINE_REACH<Size>[id];
+    staleCaptures_ |= LINE_REACH<Size>[id];
+    if (c == Cell::Black)
+        --blackStones;
+    else
+        --whiteStones;
+    // Sparse index remove via swap-pop
+    int16_t posIdx = occIdx_[id];
+    if (posIdx >= 0) {
+        const int lastIdx = static_cast<int>(occupied_.size()) - 1;
+        if (posIdx != lastIdx) {
+            Pos moved = occupied_.back();
+            occupied_[posIdx] = moved;
+            occIdx_[idx(moved.x, moved.y)] = posIdx;
+        }
+        occupied_.pop_back();
+        occIdx_[id] = -1;
+        stones_.reset(id);
+    }
+
+    // Frontière: les voisines sans autre pierre proche en sortent, la case libérée y entre
+    const auto& box = Mailbox::box(id);
+    for (int i = 0, n = Mailbox::boxCount(id); i < n; ++i) {
+        const uint16_t nb = box[i];
+        if (--nearStones_[nb] == 0)
+            frontierRemove(nb);
+    }
+    if (--nearStones_[id] > 0)
+        frontierAdd(id);
+}
+
+template <int Size>
+void BasicBoard<Size>::frontierAdd(uint16_t id)
+{
+    if (frontierIdx_[id] >= 0)
+        return;
+    frontierIdx_[id] = static_cast<int16_t>(frontier_.size());
+    frontier_.push_back(posOf(id));
+}
+
+template <int Size>
+void BasicBoard<Size>::frontierRemove(uint16_t id)
+{
+    const int16_t posIdx = frontierIdx_[id];
+    if (posIdx < 0)
+        return;
+    const int lastIdx = static_cast<int>(frontier_.size()) - 1;
+    if (posIdx != lastIdx) {
+        const Pos moved = frontier_.back();
+        frontier_[posIdx] = moved;
+        frontierIdx_[idx(moved.x, moved.y)] = posIdx;
+    }
+    frontier_.pop_back();
+    frontierIdx_[id] = -1;
+}
+
+template class BasicBoard<BOARD_SIZE>;
+template class BasicBoard<15>;
+
+// Moteur de règles spécialisé: les 8 variantes pour chaque taille de plateau
+#define GOMOKU_BOARD_VARIANT(S, I)                                                                                \
+    template PlayResult BasicBoard<S>::tryPlayFor<RuleVariant::fromIndex(I)>(Move, const RuleSet&);                 \
+    template PlayResult BasicBoard<S>::checkMoveFor<RuleVariant::fromIndex(I)>(Move, const RuleSet&) const;         \
+    template void BasicBoard<S>::doMoveFor<RuleVariant::fromIndex(I)>(Move, const RuleSet&);                        \
+    template BasicBoard<S>::CellSet BasicBoard<S>::legalMaskFor<RuleVariant::fromIndex(I)>(Player, const RuleSet&) const; \
+    template void BasicBoard<S>::legalMovesFor<RuleVariant::fromIndex(I)>(Player, const RuleSet&, MoveList&) const;
+#define GOMOKU_BOARD_VARIANTS(S) \
+    GOMOKU_BOARD_VARIANT(S, 0)   \
+    GOMOKU_BOARD_VARIANT(S, 1)   \
+    GOMOKU_BOARD_VARIANT(S, 2)   \
+    GOMOKU_BOARD_VARIANT(S, 3)   \
+    GOMOKU_BOARD_VARIANT(S, 4)   \
+    GOMOKU_BOARD_VARIANT(S, 5)   \
+    GOMOKU_BOARD_VARIANT(S, 6)   \
+    GOMOKU_BOARD_VARIANT(S, 7)
+
+GOMOKU_BOARD_VARIANTS(BOARD_SIZE)
+GOMOKU_BOARD_VARIANTS(15)
+
+#undef GOMOKU_BOARD_VARIANTS
+#undef GOMOKU_BOARD_VARIANT
+
 } // namespace gomoku
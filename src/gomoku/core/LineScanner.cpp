@@ -0,0 +1,208 @@
+#include "gomoku/core/LineScanner.hpp"
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GOMOKU_LINESCAN_X86 1
+#endif
+
+namespace gomoku::linescan {
+
+// Formulation bit-parallèle (identique pour tous les noyaux), par mot de ligne:
+//   e      = cases vides (ni pierre, ni adversaire, ni mur)
+//   starts = premières pierres de chaque série, openL = starts dont la case avant est vide
+//   g      = positions où commencent >= L pierres consécutives (g &= m >> L à chaque pas)
+//   exact  = starts & g & ~(m >> L): séries de longueur exactement L
+//   fin ouverte à droite = e >> L
+void countRunsScalar(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n, RunCounts& out)
+{
+    for (int i = 0; i < n; ++i) {
+        const uint32_t m = mine[i];
+        const uint32_t e = ~(m | theirs[i] | walls[i]);
+        const uint32_t starts = m & ~(m << 1);
+        const uint32_t openL = starts & (e << 1);
+        uint32_t g = m;
+        for (int len = 1; len <= 4; ++len) {
+            const uint32_t exact = starts & g & ~(m >> len);
+            const uint32_t right = e >> len;
+            const int all = std::popcount(exact);
+            const int both = std::popcount(exact & openL & right);
+            const int one = std::popcount(exact & (openL ^ right));
+            out.runs[len - 1][2] += both;
+            out.runs[len - 1][1] += one;
+            out.runs[len - 1][0] += all - both - one;
+            g &= m >> len;
+        }
+        out.fives += std::popcount(starts & g);
+    }
+}
+
+#ifdef GOMOKU_LINESCAN_X86
+namespace {
+    // 12 compteurs (longueur 1..4 x {toutes, deux ouvertes, une ouverte}) + les cinq
+    constexpr int ACC = 13;
+
+    void accumulate(RunCounts& out, const long long (&sums)[ACC])
+    {
+        for (int len = 0; len < 4; ++len) {
+            const int all = static_cast<int>(sums[3 * len]);
+            const int both = static_cast<int>(sums[3 * len + 1]);
+            const int one = static_cast<int>(sums[3 * len + 2]);
+            out.runs[len][2] += both;
+            out.runs[len][1] += one;
+            out.runs[len][0] += all - both - one;
+        }
+        out.fives += static_cast<int>(sums[12]);
+    }
+
+    // ---- AVX2: 8 lignes par itération ----
+    __attribute__((target("avx2"))) inline __m256i popcount8(__m256i v)
+    {
+        // popcount par octet (table de quartets), puis somme des octets par blocs de 64 bits
+        const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low));
+        const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+    }
+
+    // Séries de longueur exactement L (compteurs 3*(L-1) .. 3*(L-1)+2), puis g &= m >> L
+    template <int L>
+    __attribute__((target("avx2"))) inline void lenStepAvx2(__m256i m, __m256i e, __m256i starts, __m256i openL, __m256i& g, __m256i (&acc)[ACC])
+    {
+        const __m256i mr = _mm256_srli_epi32(m, L);
+        const __m256i exact = _mm256_andnot_si256(mr, _mm256_and_si256(starts, g));
+        const __m256i right = _mm256_srli_epi32(e, L);
+        acc[3 * (L - 1)] = _mm256_add_epi64(acc[3 * (L - 1)], popcount8(exact));
+        acc[3 * (L - 1) + 1] = _mm256_add_epi64(acc[3 * (L - 1) + 1], popcount8(_mm256_and_si256(exact, _mm256_and_si256(openL, right))));
+        acc[3 * (L - 1) + 2] = _mm256_add_epi64(acc[3 * (L - 1) + 2], popcount8(_mm256_and_si256(exact, _mm256_xor_si256(openL, right))));
+        g = _mm256_and_si256(g, mr);
+    }
+
+    __attribute__((target("avx2"))) void countRunsAvx2(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n, RunCounts& out)
+    {
+        __m256i acc[ACC];
+        for (auto& a : acc)
+            a = _mm256_setzero_si256();
+        const __m256i ones = _mm256_set1_epi32(-1);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mine + i));
+            const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(theirs + i));
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(walls + i));
+            const __m256i e = _mm256_xor_si256(_mm256_or_si256(m, _mm256_or_si256(t, w)), ones);
+            const __m256i starts = _mm256_andnot_si256(_mm256_slli_epi32(m, 1), m);
+            const __m256i openL = _mm256_and_si256(starts, _mm256_slli_epi32(e, 1));
+            __m256i g = m;
+            lenStepAvx2<1>(m, e, starts, openL, g, acc);
+            lenStepAvx2<2>(m, e, starts, openL, g, acc);
+            lenStepAvx2<3>(m, e, starts, openL, g, acc);
+            lenStepAvx2<4>(m, e, starts, openL, g, acc);
+            acc[12] = _mm256_add_epi64(acc[12], popcount8(_mm256_and_si256(starts, g)));
+        }
+        long long sums[ACC];
+        for (int k = 0; k < ACC; ++k) {
+            alignas(32) long long lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc[k]);
+            sums[k] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        }
+        accumulate(out, sums);
+        countRunsScalar(mine + i, theirs + i, walls + i, n - i, out);
+    }
+
+    // ---- SSE4.1: 4 lignes par itération ----
+    __attribute__((target("sse4.1"))) inline __m128i popcount4(__m128i v)
+    {
+        const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m128i low = _mm_set1_epi8(0x0F);
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+        return _mm_sad_epu8(_mm_add_epi8(lo, hi), _mm_setzero_si128());
+    }
+
+    template <int L>
+    __attribute__((target("sse4.1"))) inline void lenStepSse41(__m128i m, __m128i e, __m128i starts, __m128i openL, __m128i& g, __m128i (&acc)[ACC])
+    {
+        const __m128i mr = _mm_srli_epi32(m, L);
+        const __m128i exact = _mm_andnot_si128(mr, _mm_and_si128(starts, g));
+        const __m128i right = _mm_srli_epi32(e, L);
+        acc[3 * (L - 1)] = _mm_add_epi64(acc[3 * (L - 1)], popcount4(exact));
+        acc[3 * (L - 1) + 1] = _mm_add_epi64(acc[3 * (L - 1) + 1], popcount4(_mm_and_si128(exact, _mm_and_si128(openL, right))));
+        acc[3 * (L - 1) + 2] = _mm_add_epi64(acc[3 * (L - 1) + 2], popcount4(_mm_and_si128(exact, _mm_xor_si128(openL, right))));
+        g = _mm_and_si128(g, mr);
+    }
+
+    __attribute__((target("sse4.1"))) void countRunsSse41(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n, RunCounts& out)
+    {
+        __m128i acc[ACC];
+        for (auto& a : acc)
+            a = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi32(-1);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mine + i));
+            const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(theirs + i));
+            const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(walls + i));
+            const __m128i e = _mm_xor_si128(_mm_or_si128(m, _mm_or_si128(t, w)), ones);
+            const __m128i starts = _mm_andnot_si128(_mm_slli_epi32(m, 1), m);
+            const __m128i openL = _mm_and_si128(starts, _mm_slli_epi32(e, 1));
+            __m128i g = m;
+            lenStepSse41<1>(m, e, starts, openL, g, acc);
+            lenStepSse41<2>(m, e, starts, openL, g, acc);
+            lenStepSse41<3>(m, e, starts, openL, g, acc);
+            lenStepSse41<4>(m, e, starts, openL, g, acc);
+            acc[12] = _mm_add_epi64(acc[12], popcount4(_mm_and_si128(starts, g)));
+        }
+        long long sums[ACC];
+        for (int k = 0; k < ACC; ++k) {
+            alignas(16) long long lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc[k]);
+            sums[k] = lanes[0] + lanes[1];
+        }
+        accumulate(out, sums);
+        countRunsScalar(mine + i, theirs + i, walls + i, n - i, out);
+    }
+} // namespace
+#endif
+
+namespace {
+    using CountRunsFn = void (*)(const uint32_t*, const uint32_t*, const uint32_t*, int, RunCounts&);
+
+    struct Kernel {
+        CountRunsFn fn;
+        const char* name;
+    };
+
+    Kernel pickKernel()
+    {
+#ifdef GOMOKU_LINESCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return { countRunsAvx2, "avx2" };
+        if (__builtin_cpu_supports("sse4.1"))
+            return { countRunsSse41, "sse4.1" };
+#endif
+        return { countRunsScalar, "scalar" };
+    }
+
+    const Kernel& kernel()
+    {
+        static const Kernel k = pickKernel();
+        return k;
+    }
+} // namespace
+
+RunCounts countRuns(const uint32_t* mine, const uint32_t* theirs, const uint32_t* walls, int n)
+{
+    RunCounts out;
+    kernel().fn(mine, theirs, walls, n, out);
+    return out;
+}
+
+const char* backend()
+{
+    return kernel().name;
+}
+
+} // namespace gomoku::linescan
@@ -0,0 +1,271 @@
+#include "gomoku/core/SearchBoard.hpp"
+#include "gomoku/core/Zobrist.hpp"
+#include <bit>
+#include <cassert>
+
+namespace gomoku {
+
+namespace {
+    // Cases d'une couleur dans un mot packé, aux bits pairs (bit 2k = case k)
+    constexpr uint64_t EVEN_BITS = 0x5555555555555555ull;
+
+    inline uint64_t colorBits(uint64_t w, Cell c)
+    {
+        const uint64_t lo = w & EVEN_BITS, hi = (w >> 1) & EVEN_BITS;
+        return c == Cell::Black ? lo & ~hi : hi & ~lo;
+    }
+
+    // Bit 2k posé quand les cases k..k+4 sont posées
+    inline uint64_t fiveStarts(uint64_t x) { return x & (x >> 2) & (x >> 4) & (x >> 6) & (x >> 8); }
+
+    inline Cell other(Cell c) { return c == Cell::Black ? Cell::White : Cell::Black; }
+}
+
+template <int Size>
+BasicSearchBoard<Size>::BasicSearchBoard(const Board& b)
+    : packed(b.packedLines())
+    , key(b.zobristKey())
+    , stones { static_cast<int16_t>(b.stoneCount(Player::Black)), static_cast<int16_t>(b.stoneCount(Player::White)) }
+    , pairs { static_cast<int16_t>(b.capturedPairs().black), static_cast<int16_t>(b.capturedPairs().white) }
+    , five { b.bitboard().hasFive(Cell::Black), b.bitboard().hasFive(Cell::White) }
+    , side(b.toPlay())
+    , state(b.status())
+{
+}
+
+template <int Size>
+auto BasicSearchBoard<Size>::toBoard() const -> Board
+{
+    // Pose directe des pierres (pas de règles rejouées), puis compteurs, trait et statut
+    Board b;
+    for (int id = 0; id < CELLS; ++id) {
+        const Cell c = at(id);
+        if (c != Cell::Empty)
+            b.putStone(static_cast<uint16_t>(id), c);
+    }
+    b.setPairs(pairs[0], pairs[1]);
+    if (b.currentPlayer != side) {
+        b.currentPlayer = side;
+        b.toggleSideKey();
+    }
+    b.gameState = state; // les caches de lignes se mettent à jour à la première requête
+    assert(b.zobristKey() == key);
+    return b;
+}
+
+// ------------------------------------------------
+template <int Size>
+void BasicSearchBoard<Size>::putStone(int id, Cell c)
+{
+    packed.set(c, id);
+    key ^= detail::z_of<Size>(c, id);
+    ++stones[colorIndex(c)];
+}
+
+template <int Size>
+void BasicSearchBoard<Size>::takeStone(int id, Cell c)
+{
+    packed.reset(id);
+    key ^= detail::z_of<Size>(c, id);
+    --stones[colorIndex(c)];
+}
+
+template <int Size>
+void BasicSearchBoard<Size>::setPairs(int ci, int value)
+{
+    const int black = ci == 0 ? value : pairs[0];
+    const int white = ci == 1 ? value : pairs[1];
+    key ^= detail::z_pairs<Size>(pairs[0], pairs[1]) ^ detail::z_pairs<Size>(black, white);
+    pairs[ci] = static_cast<int16_t>(value);
+}
+
+template <int Size>
+bool BasicSearchBoard<Size>::hasFive(Cell c) const
+{
+    for (int line = 0; line < Bitboard::LINES; ++line)
+        if (fiveStarts(colorBits(packed.word(line), c)))
+            return true;
+    return false;
+}
+
+template <int Size>
+bool BasicSearchBoard<Size>::fiveThrough(int id, Cell c) const
+{
+    for (int d = 0; d < Bitboard::DIRS; ++d) {
+        // un départ de 5 dans [bit-4, bit] couvre la case
+        const auto s = Bitboard::slot(d, id);
+        if ((fiveStarts(colorBits(packed.word(s.line), c)) >> (2 * (s.bit - 4))) & 0x155u)
+            return true;
+    }
+    return false;
+}
+
+// Copie-make: la copie (un memcpy) subit les captures, l'original reste intact.
+// Appelé seulement quand les captures sont actives.
+template <int Size>
+bool BasicSearchBoard<Size>::captureBreaksFive(int id, Cell capturer, const RuleSet& rules) const
+{
+    const uint8_t dirs = packed.captureDirs(id, capturer);
+    if (!dirs)
+        return false;
+    if (pairs[colorIndex(capturer)] + std::popcount(dirs) >= rules.captureWinPairs)
+        return true; // victoire immédiate par captures
+
+    BasicSearchBoard copy = *this;
+    for (int d = 0; d < Bitboard::DIRS; ++d)
+        for (int sign = 0; sign < 2; ++sign) {
+            if (!(dirs & (1u << (2 * d + sign))))
+                continue;
+            const int step = sign ? -Bitboard::STEP[d] : Bitboard::STEP[d];
+            copy.packed.reset(id + step);
+            copy.packed.reset(id + 2 * step);
+        }
+    return !copy.hasFive(other(capturer));
+}
+
+template <int Size>
+template <RuleVariant V>
+bool BasicSearchBoard<Size>::fiveBreakable(Cell capturer, const RuleSet& rules) const
+{
+    if constexpr (!V.captures)
+        return false;
+    for (int id = 0; id < CELLS; ++id)
+        if (at(id) == Cell::Empty && captureBreaksFive(id, capturer, rules))
+            return true;
+    return false;
+}
+
+// Même test que Board::formsDoubleThree, sur les fenêtres packées
+template <int Size>
+bool BasicSearchBoard<Size>::formsDoubleThree(int id, Cell me, uint8_t caps) const
+{
+    int virtDir = -1;
+    uint32_t virtMask = 0;
+    if (caps) {
+        const int first = std::countr_zero(caps);
+        virtDir = first / 2;
+        virtMask = (first & 1) ? 0xF << (2 * 3) : 0xF << (2 * 6);
+    }
+    int threes = 0;
+    for (int d = 0; d < Bitboard::DIRS; ++d) {
+        uint32_t w = packed.relativeWindow(d, id, me);
+        if (d == virtDir)
+            w &= ~virtMask;
+        if (detail::isFreeThreeWindow(w) && ++threes >= 2)
+            return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------
+template <int Size>
+bool BasicSearchBoard<Size>::isLegal(Move m, const RuleSet& rules) const
+{
+    return withRuleVariant(rules.variant(), [&]<RuleVariant V>() { return isLegalFor<V>(m, rules); });
+}
+
+template <int Size>
+template <RuleVariant V>
+bool BasicSearchBoard<Size>::isLegalFor(Move m, const RuleSet& rules) const
+{
+    if (m.pos.x >= Size || m.pos.y >= Size)
+        return false;
+    if (state != GameStatus::Ongoing || m.by != side)
+        return false;
+    const int id = m.pos.y * Size + m.pos.x;
+    if (at(id) != Cell::Empty)
+        return false;
+
+    const Cell me = playerToCell(side);
+    // 5+ adverse cassable: seul un coup qui le casse est jouable (double-trois permis)
+    if constexpr (V.alignWins && V.captures) {
+        if (five[colorIndex(other(me))] && fiveBreakable<V>(me, rules))
+            return captureBreaksFive(id, me, rules);
+    }
+
+    if constexpr (!V.forbidDoubleThree)
+        return true;
+    else if constexpr (V.captures) {
+        const uint8_t caps = packed.captureDirs(id, me);
+        return caps || !formsDoubleThree(id, me, caps);
+    } else
+        return !formsDoubleThree(id, me, packed.captureDirs(id, me)); // même fenêtre que Board::forbiddenPlain_
+}
+
+template <int Size>
+void BasicSearchBoard<Size>::play(Move m, const RuleSet& rules)
+{
+    withRuleVariant(rules.variant(), [&]<RuleVariant V>() { playFor<V>(m, rules); });
+}
+
+template <int Size>
+template <RuleVariant V>
+void BasicSearchBoard<Size>::playFor(Move m, const RuleSet& rules)
+{
+    assert(isLegalFor<V>(m, rules));
+    const int id = m.pos.y * Size + m.pos.x;
+    const Cell me = playerToCell(m.by);
+    const Cell op = other(me);
+    const int mi = colorIndex(me);
+
+    putStone(id, me);
+
+    if constexpr (V.captures) {
+        const uint8_t dirs = packed.captureDirs(id, me);
+        if (dirs) {
+            for (int d = 0; d < Bitboard::DIRS; ++d)
+                for (int sign = 0; sign < 2; ++sign) {
+                    if (!(dirs & (1u << (2 * d + sign))))
+                        continue;
+                    const int step = sign ? -Bitboard::STEP[d] : Bitboard::STEP[d];
+                    takeStone(id + step, op);
+                    takeStone(id + 2 * step, op);
+                }
+            setPairs(mi, pairs[mi] + std::popcount(dirs));
+            five[colorIndex(op)] = five[colorIndex(op)] && hasFive(op);
+        }
+    }
+
+    if (fiveThrough(id, me)) {
+        five[mi] = true;
+        if constexpr (V.alignWins) {
+            if (!fiveBreakable<V>(op, rules))
+                state = GameStatus::WinByAlign;
+        }
+    }
+
+    if constexpr (V.captures) {
+        if (state == GameStatus::Ongoing && (pairs[0] >= rules.captureWinPairs || pairs[1] >= rules.captureWinPairs))
+            state = GameStatus::WinByCapture;
+    }
+
+    if (state == GameStatus::Ongoing && stones[0] + stones[1] == CELLS)
+        state = GameStatus::Draw;
+
+    side = opponent(side);
+    key ^= detail::ZOBRIST<Size>.side;
+}
+
+template class BasicSearchBoard<BOARD_SIZE>;
+template class BasicSearchBoard<15>;
+
+#define GOMOKU_SEARCH_BOARD_VARIANT(S, I)                                                                 \
+    template bool BasicSearchBoard<S>::isLegalFor<RuleVariant::fromIndex(I)>(Move, const RuleSet&) const; \
+    template void BasicSearchBoard<S>::playFor<RuleVariant::fromIndex(I)>(Move, const RuleSet&);
+#define GOMOKU_SEARCH_BOARD_VARIANTS(S)   \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 0)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 1)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 2)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 3)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 4)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 5)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 6)     \
+    GOMOKU_SEARCH_BOARD_VARIANT(S, 7)
+
+GOMOKU_SEARCH_BOARD_VARIANTS(BOARD_SIZE)
+GOMOKU_SEARCH_BOARD_VARIANTS(15)
+
+#undef GOMOKU_SEARCH_BOARD_VARIANTS
+#undef GOMOKU_SEARCH_BOARD_VARIANT
+
+} // namespace gomoku
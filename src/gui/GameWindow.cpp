@@ -45,6 +45,7 @@ void GameWindow::init()
         if (gomoku::util::Preferences::load(prefs)) {
             context_.sfxEnabled = prefs.sfxEnabled;
             context_.musicEnabled = prefs.musicEnabled;
+            context_.capturesEnabled = prefs.capturesEnabled;
             if (!prefs.theme.empty() && prefs.theme != context_.theme) {
                 resourceManager_.setTexturePackage(prefs.theme);
                 resourceManager_.setAudioPackage(prefs.theme);
@@ -9,7 +9,7 @@ namespace gomoku::scene {
 GameScene::GameScene(Context& context, bool vsAi)
     : AScene(context)
     , vsAi_(vsAi)
-    , gameSession_(gomoku::SessionController())
+    , gameSession_(context.capturesEnabled ? gomoku::RuleSet::standard() : gomoku::RuleSet::noCaptures())
 {
     // Initialisation du bouton Back
     backButton_.setPosition({ 100, 820 });
@@ -27,7 +27,7 @@ GameScene::GameScene(Context& context, bool vsAi)
             context_.resourceManager->getTexture("pawn2"));
     }
 
-    rules_ = gomoku::RuleSet();
+    rules_ = context_.capturesEnabled ? gomoku::RuleSet::standard() : gomoku::RuleSet::noCaptures();
 
     // Configure controllers according to mode
     if (vsAi_) {
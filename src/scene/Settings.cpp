@@ -56,6 +56,22 @@ SettingsScene::SettingsScene(Context& ctx)
     musicToggleBtn_.setCallback([this]() { toggleMusic(); });
     musicToggleBtn_.setHoverCallback([this]() { playSfx("ui_hover", UI_HOVER_VOLUME); });
 
+    // Bouton règles: captures activées / variante sans captures
+    capturesToggleBtn_.setPosition({ 1150, 220 });
+    capturesToggleBtn_.setSize({ 10, 10 });
+    capturesToggleBtn_.setScale(0.15f);
+    capturesToggleBtn_.setCallback([this]() { toggleCaptures(); });
+    capturesToggleBtn_.setHoverCallback([this]() { playSfx("ui_hover", UI_HOVER_VOLUME); });
+
+    fontOk_ = font_.loadFromFile("assets/ui/DejaVuSans.ttf");
+    if (fontOk_) {
+        capturesLabel_.setFont(font_);
+        capturesLabel_.setCharacterSize(28);
+        capturesLabel_.setFillColor(sf::Color::White);
+        capturesLabel_.setPosition(820.f, 225.f);
+        capturesLabel_.setString("Captures");
+    }
+
     // Texture initiale selon état
     if (context_.resourceManager) {
         const char* onKey = "sound_on";
@@ -64,6 +80,8 @@ SettingsScene::SettingsScene(Context& ctx)
             sfxToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.sfxEnabled ? onKey : offKey));
         if (context_.resourceManager->hasTexture(context_.musicEnabled ? onKey : offKey))
             musicToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.musicEnabled ? onKey : offKey));
+        if (context_.resourceManager->hasTexture(context_.capturesEnabled ? onKey : offKey))
+            capturesToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.capturesEnabled ? onKey : offKey));
     }
 }
 
@@ -76,6 +94,7 @@ void SettingsScene::update(sf::Time& deltaTime)
     backBtn_.update(deltaTime);
     sfxToggleBtn_.update(deltaTime);
     musicToggleBtn_.update(deltaTime);
+    capturesToggleBtn_.update(deltaTime);
 }
 
 void SettingsScene::render(sf::RenderTarget& target) const
@@ -87,6 +106,9 @@ void SettingsScene::render(sf::RenderTarget& target) const
     backBtn_.render(target);
     sfxToggleBtn_.render(target);
     musicToggleBtn_.render(target);
+    capturesToggleBtn_.render(target);
+    if (fontOk_)
+        target.draw(capturesLabel_);
 }
 
 void SettingsScene::onThemeChanged()
@@ -109,6 +131,8 @@ void SettingsScene::onThemeChanged()
         sfxToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.sfxEnabled ? onKey : offKey));
     if (context_.resourceManager->hasTexture(context_.musicEnabled ? onKey : offKey))
         musicToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.musicEnabled ? onKey : offKey));
+    if (context_.resourceManager->hasTexture(context_.capturesEnabled ? onKey : offKey))
+        capturesToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.capturesEnabled ? onKey : offKey));
 }
 
 bool SettingsScene::handleInput(sf::Event& event)
@@ -120,6 +144,7 @@ bool SettingsScene::handleInput(sf::Event& event)
     if (context_.window && backBtn_.handleInput(event, *context_.window)) { playSfx("ui_click", BUTTON_VOLUME); return true; }
     if (context_.window && sfxToggleBtn_.handleInput(event, *context_.window)) { playSfx("ui_click", BUTTON_VOLUME); return true; }
     if (context_.window && musicToggleBtn_.handleInput(event, *context_.window)) { playSfx("ui_click", BUTTON_VOLUME); return true; }
+    if (context_.window && capturesToggleBtn_.handleInput(event, *context_.window)) { playSfx("ui_click", BUTTON_VOLUME); return true; }
     return false;
 }
 
@@ -136,11 +161,7 @@ void SettingsScene::applyTheme(const std::string& themeName)
         std::string musicPath = std::string("assets/audio/") + themeName + "/menu_theme.ogg";
         playMusic(musicPath.c_str(), true, MUSIC_VOLUME);
         // persiste préférences
-        gomoku::util::PreferencesData prefs;
-        prefs.theme = context_.theme;
-        prefs.sfxEnabled = context_.sfxEnabled;
-        prefs.musicEnabled = context_.musicEnabled;
-        gomoku::util::Preferences::save(prefs);
+        savePreferences();
         std::cout << "Theme applied: " << themeName << std::endl;
     } else {
         std::cerr << "Failed to apply theme " << themeName << std::endl;
@@ -156,13 +177,7 @@ void SettingsScene::onBackClicked()
 void SettingsScene::toggleSfx()
 {
     context_.sfxEnabled = !context_.sfxEnabled;
-    {
-        gomoku::util::PreferencesData prefs;
-        prefs.theme = context_.theme;
-        prefs.sfxEnabled = context_.sfxEnabled;
-        prefs.musicEnabled = context_.musicEnabled;
-        gomoku::util::Preferences::save(prefs);
-    }
+    savePreferences();
     const char* onKey = "sound_on";
     const char* offKey = "sound_off";
     if (context_.resourceManager && context_.resourceManager->hasTexture(context_.sfxEnabled ? onKey : offKey))
@@ -181,19 +196,34 @@ void SettingsScene::toggleMusic()
             context_.music->setVolume(0.f);
         }
     }
-    {
-        gomoku::util::PreferencesData prefs;
-        prefs.theme = context_.theme;
-        prefs.sfxEnabled = context_.sfxEnabled;
-        prefs.musicEnabled = context_.musicEnabled;
-        gomoku::util::Preferences::save(prefs);
-    }
+    savePreferences();
     const char* onKey = "sound_on";
     const char* offKey = "sound_off";
     if (context_.resourceManager && context_.resourceManager->hasTexture(context_.musicEnabled ? onKey : offKey))
         musicToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.musicEnabled ? onKey : offKey));
 }
 
+void SettingsScene::toggleCaptures()
+{
+    // Prise en compte à la prochaine partie (GameScene lit context_.capturesEnabled)
+    context_.capturesEnabled = !context_.capturesEnabled;
+    savePreferences();
+    const char* onKey = "sound_on";
+    const char* offKey = "sound_off";
+    if (context_.resourceManager && context_.resourceManager->hasTexture(context_.capturesEnabled ? onKey : offKey))
+        capturesToggleBtn_.setTexture(&context_.resourceManager->getTexture(context_.capturesEnabled ? onKey : offKey));
+}
+
+void SettingsScene::savePreferences() const
+{
+    gomoku::util::PreferencesData prefs;
+    prefs.theme = context_.theme;
+    prefs.sfxEnabled = context_.sfxEnabled;
+    prefs.musicEnabled = context_.musicEnabled;
+    prefs.capturesEnabled = context_.capturesEnabled;
+    gomoku::util::Preferences::save(prefs);
+}
+
 } // namespace gomoku::scene
 
 
@@ -59,6 +59,7 @@ bool Preferences::load(PreferencesData& outPrefs)
     outPrefs.theme = findString("theme", outPrefs.theme);
     outPrefs.sfxEnabled = findBool("sfxEnabled", outPrefs.sfxEnabled);
     outPrefs.musicEnabled = findBool("musicEnabled", outPrefs.musicEnabled);
+    outPrefs.capturesEnabled = findBool("capturesEnabled", outPrefs.capturesEnabled);
     return true;
 }
 
@@ -70,7 +71,8 @@ bool Preferences::save(const PreferencesData& prefs)
     out << "{\n";
     out << "  \"theme\": \"" << prefs.theme << "\",\n";
     out << "  \"sfxEnabled\": " << (prefs.sfxEnabled ? "true" : "false") << ",\n";
-    out << "  \"musicEnabled\": " << (prefs.musicEnabled ? "true" : "false") << "\n";
+    out << "  \"musicEnabled\": " << (prefs.musicEnabled ? "true" : "false") << ",\n";
+    out << "  \"capturesEnabled\": " << (prefs.capturesEnabled ? "true" : "false") << "\n";
     out << "}\n";
     return true;
 }
@@ -0,0 +1,147 @@
+// Copy-make (SearchBoard) vs make-unmake (Board::doMove/undoMove) vs Board copies.
+// Build and run: make bench
+//
+// Copy-make alone is cheaper than make-unmake, but a search node also needs the child's legal
+// cells: Board keeps them (with the frontier and capture index) incrementally, SearchBoard has to
+// check every empty cell. The "node" lines measure that, and are why the search stays on Board.
+#include "gomoku/core/Board.hpp"
+#include "gomoku/core/SearchBoard.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace gomoku;
+
+namespace {
+
+struct BenchPosition {
+    Board board;
+    std::vector<Move> moves; // legal moves near the stones
+};
+
+// Middle-game positions reached by random legal playouts around the center
+std::vector<BenchPosition> makePositions(int count, int plies, const RuleSet& rules)
+{
+    std::mt19937 rng(42);
+    std::vector<BenchPosition> out;
+    while (static_cast<int>(out.size()) < count) {
+        Board b;
+        b.doMove({ Pos { 9, 9 }, Player::Black }, rules);
+        for (int i = 1; i < plies && b.status() == GameStatus::Ongoing; ++i) {
+            const auto legal = b.legalMoves(b.toPlay(), rules);
+            if (legal.empty())
+                break;
+            b.doMove(legal[rng() % legal.size()], rules);
+        }
+        if (b.status() != GameStatus::Ongoing)
+            continue;
+        auto moves = b.legalMoves(b.toPlay(), rules);
+        if (!moves.empty())
+            out.push_back({ b, std::move(moves) });
+    }
+    return out;
+}
+
+template <class F>
+double nsPerMove(const std::vector<BenchPosition>& positions, int rounds, F&& f)
+{
+    using Clock = std::chrono::steady_clock;
+    long long count = 0;
+    const auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& p : positions)
+            count += f(p);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    return static_cast<double>(ns) / static_cast<double>(count);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    const RuleSet rules {};
+    const auto positions = makePositions(200, 40, rules);
+    uint64_t sink = 0;
+
+    std::vector<SearchBoard> compact;
+    compact.reserve(positions.size());
+    for (const auto& p : positions)
+        compact.emplace_back(p.board);
+
+    // 1) make-unmake on a Board (incremental state, undo stack)
+    std::vector<Board> boards;
+    for (const auto& p : positions)
+        boards.push_back(p.board);
+    std::size_t i = 0;
+    const double makeUnmake = nsPerMove(positions, rounds, [&](const BenchPosition& p) {
+        Board& b = boards[i++ % boards.size()];
+        for (const Move& m : p.moves) {
+            b.doMove(m, rules);
+            sink += b.zobristKey();
+            b.undoMove();
+        }
+        return static_cast<long long>(p.moves.size());
+    });
+
+    // 2) copy-make on a SearchBoard (one memcpy per child, no undo)
+    i = 0;
+    const double copyMake = nsPerMove(positions, rounds, [&](const BenchPosition& p) {
+        const SearchBoard& parent = compact[i++ % compact.size()];
+        for (const Move& m : p.moves) {
+            SearchBoard child = parent;
+            child.play(m, rules);
+            sink += child.zobristKey();
+        }
+        return static_cast<long long>(p.moves.size());
+    });
+
+    // 3) copy-make on a Board (heap copies of history and sparse indexes)
+    const double boardCopy = nsPerMove(positions, rounds, [&](const BenchPosition& p) {
+        for (const Move& m : p.moves) {
+            Board child = p.board;
+            child.doMove(m, rules);
+            sink += child.zobristKey();
+        }
+        return static_cast<long long>(p.moves.size());
+    });
+
+    // 4) A search node: the move plus the child's legal cells, as the move generators need them.
+    //    Board reads its incremental masks; SearchBoard checks every empty cell.
+    i = 0;
+    const double boardNode = nsPerMove(positions, rounds, [&](const BenchPosition& p) {
+        Board& b = boards[i++ % boards.size()];
+        for (const Move& m : p.moves) {
+            b.doMove(m, rules);
+            sink += static_cast<uint64_t>(b.legalMask(b.toPlay(), rules).count());
+            b.undoMove();
+        }
+        return static_cast<long long>(p.moves.size());
+    });
+    i = 0;
+    const double compactNode = nsPerMove(positions, rounds, [&](const BenchPosition& p) {
+        const SearchBoard& parent = compact[i++ % compact.size()];
+        for (const Move& m : p.moves) {
+            SearchBoard child = parent;
+            child.play(m, rules);
+            int legal = 0;
+            for (uint16_t id = 0; id < SearchBoard::CELLS; ++id)
+                legal += child.isLegal({ Pos::fromIndex(id), child.toPlay() }, rules) ? 1 : 0;
+            sink += static_cast<uint64_t>(legal);
+        }
+        return static_cast<long long>(p.moves.size());
+    });
+
+    std::printf("positions: %zu, sizeof(SearchBoard) = %zu bytes, sizeof(Board) = %zu bytes (+ heap)\n",
+        positions.size(), sizeof(SearchBoard), sizeof(Board));
+    std::printf("make-unmake  Board       : %8.1f ns/move\n", makeUnmake);
+    std::printf("copy-make    SearchBoard : %8.1f ns/move\n", copyMake);
+    std::printf("copy-make    Board       : %8.1f ns/move\n", boardCopy);
+    std::printf("node         Board       : %8.1f ns/move\n", boardNode);
+    std::printf("node         SearchBoard : %8.1f ns/move\n", compactNode);
+    std::printf("(checksum %016llx)\n", static_cast<unsigned long long>(sink));
+    return 0;
+}
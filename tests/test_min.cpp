@@ -1,16 +1,28 @@
 #include "board_print.hpp"
+#include "gomoku/ai/CandidateGenerator.hpp"
+#include "gomoku/ai/MinimaxSearchEngine.hpp"
+#include "gomoku/ai/PvTable.hpp"
+#include "gomoku/ai/SearchArena.hpp"
 #include "gomoku/application/SessionController.hpp"
 #include "gomoku/core/Board.hpp"
+#include "gomoku/core/SearchBoard.hpp"
 #include "gomoku/core/Types.hpp"
 #include "test_framework.hpp"
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 using namespace gomoku;
 
+// Configuration minimale des parties de test (règles uniquement)
+struct EngineConfig {
+    RuleSet rules {};
+};
+
 // Adapter minimal pour remplacer Engine dans les tests
 // Fournit une façade légère autour de SessionController pour conserver les mêmes appels.
 struct TestEngine {
@@ -58,6 +70,22 @@ struct TestEngine {
     }
 };
 
+namespace {
+// Black five on row 10 (x=5..9); its stone (7,10) pairs with (7,11) under White (7,9),
+// so White must break it by capturing at (7,12). White to move.
+const Pos BREAKABLE_FIVE[] = { { 5, 10 }, { 7, 9 }, { 6, 10 }, { 0, 0 }, { 7, 11 }, { 0, 2 },
+    { 8, 10 }, { 0, 4 }, { 9, 10 }, { 0, 6 }, { 7, 10 } };
+// Black (7,10), White (8,10) (9,10): the last move, Black (10,10), captures the pair
+const Pos CAPTURE_PAIR[] = { { 7, 10 }, { 8, 10 }, { 0, 0 }, { 9, 10 }, { 10, 10 } };
+
+// Plays seq on b, sides alternating from the side to move
+void play(Board& b, std::span<const Pos> seq, const RuleSet& rules = {})
+{
+    for (const auto& p : seq)
+        REQUIRE(b.tryPlay({ p, b.toPlay() }, rules).success);
+}
+} // namespace
+
 TEST(empty_board_draw_false)
 {
     TestEngine e {};
@@ -80,6 +108,525 @@ TEST(align_win)
     REQUIRE(e.board().status() == GameStatus::WinByAlign);
 }
 
+TEST(align_win_anti_diagonal_on_edge)
+{
+    TestEngine e {};
+    // Black aligns (4,0) (3,1) (2,2) (1,3) (0,4): anti-diagonal touching two borders
+    for (int k = 0; k < 5; ++k) {
+        bool ok = e.play({ Pos { (uint8_t)(4 - k), (uint8_t)k }, e.board().toPlay() });
+        REQUIRE(ok);
+        if (k < 4) { // white plays far away, spaced to avoid any shape
+            ok = e.play({ Pos { (uint8_t)(10 + 2 * k), (uint8_t)10 }, e.board().toPlay() });
+            REQUIRE(ok);
+        }
+    }
+    REQUIRE(e.board().status() == GameStatus::WinByAlign);
+}
+
+TEST(breakable_five_must_be_broken)
+{
+    TestEngine e {};
+    for (const auto& p : BREAKABLE_FIVE)
+        REQUIRE(e.play({ p, e.board().toPlay() }));
+    // The five can be broken by capture: no win yet, and White must capture
+    CHECK(e.board().status() == GameStatus::Ongoing);
+    CHECK(!e.play({ Pos { 0, 8 }, e.board().toPlay() }));
+    CHECK(e.play({ Pos { 7, 12 }, e.board().toPlay() }));
+    CHECK(e.board().at(7, 10) == Cell::Empty);
+    CHECK(e.board().status() == GameStatus::Ongoing);
+}
+
+TEST(check_move_is_read_only_and_precise)
+{
+    RuleSet rules {};
+    Board b;
+    play(b, BREAKABLE_FIVE, rules);
+    const uint64_t key = b.zobristKey();
+    CHECK(b.checkMove({ Pos { 0, 8 }, b.toPlay() }, rules).code == PlayErrorCode::RuleViolation);
+    CHECK(b.checkMove({ Pos { 0, 0 }, b.toPlay() }, rules).code == PlayErrorCode::Occupied);
+    CHECK(b.checkMove({ Pos { 1, 1 }, opponent(b.toPlay()) }, rules).code == PlayErrorCode::NotPlayersTurn);
+    CHECK(b.checkMove({ Pos { 7, 12 }, b.toPlay() }, rules).success);
+    CHECK(b.zobristKey() == key);
+    CHECK(b.at(7, 10) == Cell::Black);
+
+    // The service reports the same codes from its single validated-play pass
+    application::GameService svc;
+    CHECK(svc.makeMove(Move { Pos { 9, 9 }, Player::White }).code == PlayErrorCode::NotPlayersTurn);
+    CHECK(svc.makeMove(Pos { 9, 9 }).success);
+    CHECK(svc.makeMove(Pos { 9, 9 }).code == PlayErrorCode::Occupied);
+    CHECK(svc.makeMove(Pos { 30, 9 }).code == PlayErrorCode::InvalidPosition);
+    CHECK(svc.getMoveHistory().size() == 1);
+}
+
+TEST(legal_mask_covers_occupancy_double_three_and_must_break)
+{
+    RuleSet rules {};
+    Board b;
+    CHECK(b.legalMask(Player::Black, rules).count() == CellSet::CELLS);
+    // Must-break: once Black's breakable five stands, White's only legal cells break it
+    play(b, BREAKABLE_FIVE, rules);
+    const CellSet mask = b.legalMask(Player::White, rules);
+    CHECK(mask.count() == 1);
+    CHECK(mask.test(Pos { 7, 12 }.toIndex()));
+    CHECK(b.legalMoves(Player::White, rules).size() == 1);
+    // Without the five, occupied cells and double-threes are excluded
+    REQUIRE(b.tryPlay({ Pos { 7, 12 }, Player::White }, rules).success);
+    int agree = 0;
+    const CellSet black = b.legalMask(Player::Black, rules);
+    for (uint16_t id = 0; id < CellSet::CELLS; ++id)
+        agree += black.test(id) == b.checkMove({ Pos::fromIndex(id), Player::Black }, rules).success;
+    CHECK(agree == CellSet::CELLS);
+}
+
+TEST(line_caches_match_a_full_recomputation)
+{
+    RuleSet rules {};
+    // Every incremental cache against a Board rebuilt from the stones alone
+    auto matchesRebuilt = [&](const Board& b) {
+        const Board ref = SearchBoard(b).toBoard();
+        for (Player p : { Player::Black, Player::White }) {
+            CHECK(b.doubleThreeMask(p, rules) == ref.doubleThreeMask(p, rules));
+            CHECK(b.doubleThreeMask(p, RuleSet::noCaptures()) == ref.doubleThreeMask(p, RuleSet::noCaptures()));
+            CHECK(b.captureMask(p) == ref.captureMask(p));
+            CHECK(b.exposedStones(p) == ref.exposedStones(p));
+            CHECK(b.exposedPairs(p) == ref.exposedPairs(p));
+        }
+    };
+    // Black's double-three at (10,10): row (11..12, 10) and column (10, 11..12).
+    // White (12,12) then captures (12,10) (12,11) and breaks the row three.
+    Board b;
+    const Pos seq[] = { { 11, 10 }, { 12, 9 }, { 12, 10 }, { 0, 0 }, { 10, 11 }, { 0, 2 }, { 10, 12 }, { 0, 4 }, { 12, 11 } };
+    play(b, seq, rules);
+    const uint16_t cross = Pos { 10, 10 }.toIndex();
+    CHECK(b.doubleThreeMask(Player::Black, rules).test(cross));
+    matchesRebuilt(b);
+
+    REQUIRE(b.tryPlay({ Pos { 12, 12 }, Player::White }, rules).success);
+    CHECK(b.capturedPairs().white == 1);
+    CHECK(!b.doubleThreeMask(Player::Black, rules).test(cross));
+    matchesRebuilt(b);
+    // Undo puts back the entries refreshed after the capture
+    REQUIRE(b.undo());
+    CHECK(b.doubleThreeMask(Player::Black, rules).test(cross));
+    matchesRebuilt(b);
+
+    // Capture and a reply with no query in between, then back again
+    b.doMove({ Pos { 12, 12 }, Player::White }, rules);
+    b.doMove({ Pos { 10, 10 }, Player::Black }, rules);
+    matchesRebuilt(b);
+    b.undoMove();
+    matchesRebuilt(b);
+    b.undoMove();
+    CHECK(b.doubleThreeMask(Player::Black, rules).test(cross));
+    matchesRebuilt(b);
+    while (b.undo()) { }
+    CHECK(!b.captureMask(Player::Black).any() && !b.doubleThreeMask(Player::Black, rules).any());
+    matchesRebuilt(b);
+}
+
+namespace {
+// Forwarding view that is not a Board (the engine cannot copy it)
+struct ForwardingView : IBoardView {
+    const Board& b;
+    explicit ForwardingView(const Board& board)
+        : b(board)
+    {
+    }
+    Cell at(uint8_t x, uint8_t y) const override { return b.at(x, y); }
+    Player toPlay() const override { return b.toPlay(); }
+    CaptureCount capturedPairs() const override { return b.capturedPairs(); }
+    GameStatus status() const override { return b.status(); }
+    bool isBoardFull() const override { return b.isBoardFull(); }
+    std::vector<Move> legalMoves(Player p, const RuleSet& r) const override { return b.legalMoves(p, r); }
+    uint64_t zobristKey() const override { return b.zobristKey(); }
+};
+}
+
+TEST(search_engine_follows_move_notifications)
+{
+    RuleSet rules {};
+    ai::MinimaxSearchEngine engine;
+    Board b;
+    const Pos seq[] = { { 9, 9 }, { 10, 10 }, { 9, 10 }, { 8, 8 }, { 11, 9 } };
+    for (const auto& p : seq) {
+        const Move m { p, b.toPlay() };
+        REQUIRE(b.tryPlay(m, rules).success);
+        engine.onMovePlayed(m, rules);
+    }
+    REQUIRE(b.undo());
+    engine.onUndo();
+    const ForwardingView view(b);
+    CHECK(engine.evaluatePosition(view, Player::Black) == engine.evaluatePosition(b, Player::Black));
+    CHECK(engine.getOrderedMoves(view, rules).size() == engine.getOrderedMoves(b, rules).size());
+    CHECK(!engine.getOrderedMoves(view, rules).empty());
+    // Out of sync and not a Board: no silent fallback to an empty board
+    engine.onNewGame();
+    CHECK(engine.getOrderedMoves(view, rules).empty());
+}
+
+TEST(search_board_copy_make_matches_board)
+{
+    RuleSet rules {};
+    Board b;
+    SearchBoard s(b);
+    for (const auto& p : CAPTURE_PAIR) {
+        const Move m { p, b.toPlay() };
+        CHECK(s.isLegal(m, rules));
+        SearchBoard child = s; // copy-make
+        child.play(m, rules);
+        REQUIRE(b.tryPlay(m, rules).success);
+        s = child;
+        CHECK(s.zobristKey() == b.zobristKey());
+    }
+    CHECK(s.capturedPairs().black == 1);
+    CHECK(s.at(8, 10) == Cell::Empty);
+    CHECK(s.stoneCount(Player::White) == 0);
+    CHECK(!s.isLegal({ Pos { 10, 10 }, s.toPlay() }, rules));
+    const Board back = s.toBoard();
+    CHECK(back.zobristKey() == b.zobristKey());
+    CHECK(back.capturedPairs() == b.capturedPairs());
+    CHECK(back.legalMask(back.toPlay(), rules) == b.legalMask(b.toPlay(), rules));
+}
+
+TEST(move_list_matches_vector_api)
+{
+    RuleSet rules {};
+    Board b;
+    REQUIRE(b.tryPlay({ Pos { 9, 9 }, Player::Black }, rules).success);
+    REQUIRE(b.tryPlay({ Pos { 10, 9 }, Player::White }, rules).success);
+
+    PackedMove pm(Pos { 18, 18 }, PackedMove::CAPTURE);
+    CHECK(pm.pos() == (Pos { 18, 18 }));
+    CHECK(pm.has(PackedMove::CAPTURE) && !pm.has(PackedMove::THREAT));
+    CHECK(pm == PackedMove(Pos { 18, 18 }));
+    CHECK(PackedMove::none().isNone());
+
+    MoveList list;
+    b.legalMoves(b.toPlay(), rules, list);
+    const auto legal = b.legalMoves(b.toPlay(), rules);
+    REQUIRE(list.size() == static_cast<int>(legal.size()));
+    CHECK(list.toMoves(b.toPlay()) == legal);
+
+    CandidateGenerator::generate(b, rules, b.toPlay(), CandidateConfig {}, list);
+    CHECK(list.toMoves(b.toPlay()) == CandidateGenerator::generate(b, rules, b.toPlay(), CandidateConfig {}));
+}
+
+TEST(pv_table_and_search_arena)
+{
+    // Triangular PV: each ply's row is its move followed by the child's row
+    PvTable pv;
+    pv.clear(2);
+    pv.update(2, PackedMove(Pos { 3, 3 }));
+    pv.update(1, PackedMove(Pos { 2, 2 }));
+    pv.update(0, PackedMove(Pos { 1, 1 }));
+    std::vector<Move> line;
+    pv.copyLine(0, Player::White, line);
+    REQUIRE(line.size() == 3);
+    CHECK(line[0].pos == (Pos { 1, 1 }) && line[0].by == Player::White);
+    CHECK(line[2].pos == (Pos { 3, 3 }) && line[2].by == Player::White);
+    pv.clear(PvTable::MAX_PLY - 1);
+    pv.update(PvTable::MAX_PLY - 1, PackedMove(Pos { 4, 4 }));
+    CHECK(pv.size(PvTable::MAX_PLY - 1) == 1);
+
+    // Bump arena: LIFO release through scopes, nullptr when full
+    SearchArena arena(4096);
+    MoveList* root = arena.allocate<MoveList>();
+    REQUIRE(root != nullptr);
+    CHECK(root->empty());
+    const std::size_t used = arena.used();
+    {
+        SearchArena::Scope scope(arena);
+        CHECK(arena.allocate<MoveList>() != nullptr);
+        CHECK(arena.allocate<MoveList>(10) == nullptr);
+    }
+    CHECK(arena.used() == used);
+    arena.reset();
+    CHECK(arena.used() == 0);
+    CHECK(arena.highWater() >= 2 * sizeof(MoveList));
+}
+
+TEST(rule_variants_specialize_the_rule_engine)
+{
+    for (int i = 0; i < RuleVariant::COUNT; ++i)
+        CHECK(RuleVariant::fromIndex(i).index() == i);
+    CHECK(RuleSet::noCaptures().variant().index() == RuleVariant::fromIndex(6).index());
+    CHECK(withRuleVariant(RuleSet::freeStyle().variant(), []<RuleVariant V>() { return !V.captures && !V.forbidDoubleThree && V.alignWins; }));
+
+    // Black's XOOX on row 10: a capture under the standard rules, nothing under no-captures
+    constexpr RuleSet plain = RuleSet::noCaptures();
+    Board standard, noCapt, specialized;
+    SearchBoard compact;
+    for (const auto& p : CAPTURE_PAIR) {
+        REQUIRE(standard.tryPlay({ p, standard.toPlay() }, RuleSet::standard()).success);
+        REQUIRE(noCapt.tryPlay({ p, noCapt.toPlay() }, plain).success);
+        REQUIRE(specialized.tryPlayFor<plain.variant()>({ p, specialized.toPlay() }, plain).success);
+        compact.playFor<plain.variant()>({ p, compact.toPlay() }, plain);
+    }
+    CHECK(standard.capturedPairs().black == 1);
+    CHECK(noCapt.capturedPairs().black == 0);
+    CHECK(noCapt.at(8, 10) == Cell::White);
+    CHECK(specialized.zobristKey() == noCapt.zobristKey());
+    CHECK(compact.zobristKey() == noCapt.zobristKey());
+    CHECK(noCapt.legalMaskFor<plain.variant()>(Player::White, plain) == noCapt.legalMask(Player::White, plain));
+}
+
+TEST(capture_threat_index_tracks_pairs)
+{
+    RuleSet rules {};
+    Board b;
+    // Everything but the capture itself: Black captures at (10,10)
+    play(b, std::span(CAPTURE_PAIR).first(4), rules);
+    const Pos hit { 10, 10 };
+    CHECK(b.captureMask(Player::Black).count() == 1);
+    CHECK(b.captureMask(Player::Black).test(hit.toIndex()));
+    CHECK(b.captureDirs(hit, Player::Black) != 0);
+    CHECK(b.exposedPairs(Player::White) == 1);
+    CHECK(b.exposedStones(Player::White).test(Pos { 8, 10 }.toIndex()));
+    CHECK(b.exposedStones(Player::White).test(Pos { 9, 10 }.toIndex()));
+    CHECK(!b.captureMask(Player::White).any());
+
+    REQUIRE(b.tryPlay({ hit, Player::Black }, rules).success);
+    CHECK(!b.captureMask(Player::Black).any());
+    CHECK(b.exposedPairs(Player::White) == 0);
+    CHECK(!b.exposedStones(Player::White).any());
+
+    REQUIRE(b.undo());
+    CHECK(b.captureMask(Player::Black).test(hit.toIndex()));
+    CHECK(b.exposedPairs(Player::White) == 1);
+}
+
+namespace {
+// Black four (5..8, 9) closed by White (4,9): White must take (9,9)
+const Pos CLOSED_FOUR[] = { { 5, 9 }, { 4, 9 }, { 6, 9 }, { 0, 0 }, { 7, 9 }, { 18, 0 }, { 8, 9 } };
+
+// A position set up for MinimaxSearch with a 1 MiB table and a generous time budget
+struct SearchFixture {
+    RuleSet rules {};
+    Board board;
+    MinimaxSearch search;
+    SearchStats stats;
+
+    explicit SearchFixture(int depth, int threads = 1, ParallelMode mode = ParallelMode::LazySmp,
+        std::span<const Pos> seq = CLOSED_FOUR)
+        : search(config(depth, threads, mode))
+    {
+        play(board, seq, rules);
+        search.setTranspositionTableSize(1 << 20);
+    }
+
+    static SearchConfig config(int depth, int threads, ParallelMode mode)
+    {
+        SearchConfig cfg;
+        cfg.timeBudgetMs = 10'000;
+        cfg.maxDepthHint = depth;
+        cfg.threads = threads;
+        cfg.parallel = mode;
+        return cfg;
+    }
+
+    // Best move for the side to move; the board must come back unchanged
+    std::optional<Move> run()
+    {
+        const uint64_t key = board.zobristKey();
+        const auto best = search.bestMove(board, rules, &stats);
+        CHECK(board.zobristKey() == key);
+        return best;
+    }
+};
+} // namespace
+
+TEST(pvs_search_blocks_a_four_and_reports_its_line)
+{
+    SearchFixture f(3);
+    const auto best = f.run();
+    REQUIRE(best.has_value());
+    CHECK(best->pos == (Pos { 9, 9 }));
+    CHECK(f.stats.depthReached == 3);
+    REQUIRE(!f.stats.principalVariation.empty());
+    CHECK(f.stats.principalVariation.front().pos == best->pos);
+}
+
+TEST(lazy_smp_search_counts_threads_and_drops_helpers)
+{
+    SearchFixture f(3, 4);
+    const auto best = f.run();
+    REQUIRE(best.has_value());
+    CHECK(best->pos == (Pos { 9, 9 }));
+    CHECK(f.stats.depthReached == 3);
+    REQUIRE(f.stats.threadNodes.size() == 4);
+    long long sum = 0;
+    for (const long long n : f.stats.threadNodes)
+        sum += n;
+    CHECK(f.stats.nodes == sum);
+    CHECK(f.stats.threadNodes[0] > 0);
+
+    // Back to one thread: the helpers are dropped
+    f.search.setThreads(1);
+    REQUIRE(f.run().has_value());
+    CHECK(f.stats.threadNodes.size() == 1);
+}
+
+TEST(ybwc_search_agrees_with_the_serial_search)
+{
+    // Black's three (9..11, 9) closed by White (8,9): White has several sensible replies
+    const Pos seq[] = { { 9, 9 }, { 10, 10 }, { 10, 9 }, { 8, 9 }, { 11, 9 } };
+    SearchFixture serial(4, 1, ParallelMode::LazySmp, seq);
+    const auto expected = serial.run();
+    REQUIRE(expected.has_value());
+    REQUIRE(!serial.stats.principalVariation.empty());
+
+    SearchFixture f(4, 3, ParallelMode::Ybwc, seq);
+    const auto best = f.run();
+    REQUIRE(best.has_value());
+    CHECK(best->pos == expected->pos);
+    CHECK(f.stats.depthReached == serial.stats.depthReached);
+    REQUIRE(f.stats.threadNodes.size() == 3);
+    REQUIRE(!f.stats.principalVariation.empty());
+    CHECK(f.stats.principalVariation.front().pos == serial.stats.principalVariation.front().pos);
+}
+
+TEST(threat_solver_finds_a_vcf_and_the_search_plays_it)
+{
+    // Black's closed three on row 9 and three on column 8: (8,9) starts a VCF
+    const Pos seq[] = { { 5, 9 }, { 4, 9 }, { 6, 9 }, { 0, 0 }, { 7, 9 }, { 18, 0 },
+        { 8, 6 }, { 0, 18 }, { 8, 7 }, { 18, 18 }, { 8, 8 }, { 17, 0 } };
+    SearchFixture f(4, 1, ParallelMode::LazySmp, seq);
+    const uint64_t key = f.board.zobristKey();
+
+    CHECK(ThreatSolver::canStartVcf(f.board, f.rules));
+    ThreatSolver solver(1 << 10);
+    const auto vcf = solver.solve(f.board, f.rules, ThreatSolver::Mode::Vcf, 8, 10'000);
+    REQUIRE(vcf.move.has_value());
+    CHECK(vcf.move->by == Player::Black);
+    CHECK(vcf.plies >= 3 && vcf.plies % 2 == 1);
+    CHECK(vcf.nodes > 0);
+    CHECK(f.board.zobristKey() == key);
+
+    // White to move after a quiet black stone: no forced win for White
+    Board quiet;
+    REQUIRE(quiet.tryPlay({ { 9, 9 }, Player::Black }, f.rules).success);
+    CHECK(!ThreatSolver::canStartVcf(quiet, f.rules));
+    CHECK(!solver.solve(quiet, f.rules, ThreatSolver::Mode::Vct, 4, 10'000).move.has_value());
+
+    const auto best = f.run();
+    REQUIRE(best.has_value());
+    CHECK(best->pos == vcf.move->pos);
+    CHECK(f.stats.depthReached == vcf.plies);
+    CHECK(f.stats.threatNodes > 0);
+}
+
+TEST(transposition_table_buckets_and_aging)
+{
+    using Flag = TranspositionTable::Flag;
+    TranspositionTable tt;
+    tt.resizeBytes(64 << 10);
+    CHECK(tt.sizeBytes() == (64u << 10));
+    // Keys sharing their low bits land in the same 4-slot bucket
+    auto key = [](uint64_t i) { return 7 + (i << 32); };
+    const PackedMove m1 = PackedMove::fromIndex(42);
+    CHECK(!tt.store(key(1), 5, 100, Flag::Exact, m1));
+    CHECK(!tt.store(key(2), 4, 0, Flag::Lower, PackedMove::none()));
+    CHECK(!tt.store(key(3), 3, 0, Flag::Upper, PackedMove::none()));
+    CHECK(!tt.store(key(4), 1, 0, Flag::Exact, PackedMove::none())); // always-replace slot
+    CHECK(tt.store(key(5), 2, 0, Flag::Exact, PackedMove::none())); // evicts key 4 only
+    TranspositionTable::Hit hit;
+    CHECK(!tt.probe(key(4), hit));
+    REQUIRE(tt.probe(key(1), hit));
+    CHECK(hit.depth == 5 && hit.score == 100 && hit.flag == Flag::Exact && hit.best == m1);
+    // A shallower bound does not overwrite a deeper entry; an update without a move keeps it
+    tt.store(key(1), 2, -5, Flag::Upper, PackedMove::none());
+    REQUIRE(tt.probe(key(1), hit));
+    CHECK(hit.depth == 5);
+    tt.store(key(1), 6, 7, Flag::Exact, PackedMove::none());
+    REQUIRE(tt.probe(key(1), hit));
+    CHECK(hit.depth == 6 && hit.best == m1);
+    // Next search: older entries are replaced first, whatever their depth
+    tt.newSearch();
+    CHECK(!tt.store(key(6), 1, 0, Flag::Exact, PackedMove::none()));
+    CHECK(tt.probe(key(6), hit));
+    CHECK(!tt.probe(key(3), hit));
+    CHECK(tt.probe(key(1), hit));
+    tt.clear();
+    CHECK(!tt.probe(key(1), hit));
+}
+
+TEST(small_board_15x15_edges)
+{
+    BasicBoard<15> b;
+    RuleSet rules {};
+    // Black fills the last column (x=14) from y=10 to y=14; White plays along the first row
+    for (uint8_t i = 0; i < 5; ++i) {
+        REQUIRE(b.tryPlay({ Pos { 14, static_cast<uint8_t>(10 + i) }, Player::Black }, rules).success);
+        if (i < 4)
+            REQUIRE(b.tryPlay({ Pos { static_cast<uint8_t>(2 * i), 0 }, Player::White }, rules).success);
+    }
+    CHECK(b.status() == GameStatus::WinByAlign);
+    CHECK(!b.isInside(15, 0));
+    CHECK(b.at(14, 14) == Cell::Black);
+    REQUIRE(b.undo());
+    CHECK(b.status() == GameStatus::Ongoing);
+    CHECK(b.at(14, 14) == Cell::Empty);
+}
+
+TEST(symmetry_keys_match_transformed_positions)
+{
+    RuleSet rules {};
+    const Pos moves[] = { { 3, 4 }, { 10, 9 }, { 3, 5 }, { 17, 1 }, { 6, 12 } };
+    Board a;
+    for (const auto& p : moves)
+        REQUIRE(a.tryPlay({ p, a.toPlay() }, rules).success);
+    for (int t = 0; t < Board::SYMMETRIES; ++t) {
+        Board b;
+        for (const auto& p : moves)
+            REQUIRE(b.tryPlay({ Board::transform(p, t), b.toPlay() }, rules).success);
+        CHECK(b.zobristKey() == a.symmetryKey(t));
+        CHECK(b.canonicalKey() == a.canonicalKey());
+        CHECK(Board::transform(Board::transform(moves[0], t), Board::inverseTransform(t)) == moves[0]);
+    }
+}
+
+TEST(zobrist_key_covers_capture_counts)
+{
+    RuleSet rules {};
+    // a: Black captures W (8,10),(9,10) and ends with stones (7,10),(0,0),(10,10)
+    Board a;
+    play(a, CAPTURE_PAIR, rules);
+    REQUIRE(a.capturedPairs().black == 1);
+    // b: same stones and side to move, no capture
+    Board b;
+    const Pos blacks[] = { { 7, 10 }, { 0, 0 }, { 10, 10 } };
+    for (const auto& p : blacks) {
+        b.forceSide(Player::Black);
+        REQUIRE(b.tryPlay({ p, Player::Black }, rules).success);
+    }
+    REQUIRE(b.toPlay() == a.toPlay());
+    CHECK(a.zobristKey() != b.zobristKey());
+    CHECK(a.canonicalKey() != b.canonicalKey());
+}
+
+TEST(line_scanner_backends_agree)
+{
+    RuleSet rules {};
+    rules.forbidDoubleThree = false;
+    Board b;
+    // Mixed runs, split shapes and stones on the edges
+    const Pos seq[] = { { 9, 9 }, { 0, 0 }, { 10, 9 }, { 1, 0 }, { 11, 9 }, { 18, 18 }, { 9, 10 }, { 17, 18 },
+        { 13, 9 }, { 0, 18 }, { 9, 11 }, { 18, 0 }, { 10, 10 }, { 5, 5 }, { 8, 8 }, { 6, 6 } };
+    for (const auto& p : seq)
+        REQUIRE(b.tryPlay({ p, b.toPlay() }, rules).success);
+    for (Player p : { Player::Black, Player::White }) {
+        const Cell me = playerToCell(p), op = playerToCell(opponent(p));
+        RunCounts ref;
+        linescan::countRunsScalar(b.bitboard().lines(me).data(), b.bitboard().lines(op).data(),
+            Bitboard::walls().data(), Bitboard::LINES, ref);
+        const RunCounts got = b.runCounts(p);
+        CHECK(got.runs == ref.runs);
+        CHECK(got.fives == ref.fives);
+    }
+    // Black (9,9)-(10,9)-(11,9): one open three on the row
+    CHECK(b.runCounts(Player::Black).runs[2][2] >= 1);
+}
+
 TEST(capture_basic)
 {
     TestEngine e {};
@@ -179,6 +726,28 @@ TEST(double_three_illegal_diag_vertical)
     CHECK(why.find("double-three") != std::string::npos);
 }
 
+TEST(double_three_illegal_white_split_threes)
+{
+    TestEngine e {};
+    std::string why;
+    // White at (10,10) would make two split open threes: 0 1 0 11 0 horizontally, 0 11 0 1 0 vertically
+    const Pos whites[] = { { 8, 10 }, { 11, 10 }, { 10, 7 }, { 10, 8 } };
+    const Pos blacks[] = { { 0, 0 }, { 0, 2 }, { 0, 4 }, { 0, 6 }, { 0, 8 } };
+    bool ok;
+    for (int i = 0; i < 4; ++i) {
+        ok = e.play({ blacks[i], e.board().toPlay() }); // B elsewhere
+        REQUIRE(ok);
+        ok = e.play({ whites[i], e.board().toPlay() }); // W
+        REQUIRE(ok);
+    }
+    ok = e.play({ blacks[4], e.board().toPlay() }); // B elsewhere
+    REQUIRE(ok);
+    Move m { Pos { 10, 10 }, e.board().toPlay() };
+    ok = e.isLegal(m, &why);
+    CHECK(!ok);
+    CHECK(why.find("double-three") != std::string::npos);
+}
+
 TEST(double_three_allowed_if_capture)
 {
     TestEngine e {};
@@ -272,6 +841,28 @@ TEST(undo_restores_state_and_zobrist)
     CHECK(e.board().toPlay() == Player::White);
 }
 
+TEST(do_move_undo_move_restores_captures)
+{
+    Board b;
+    RuleSet rules {};
+    // B (7,10), W (8,10), B (0,0), W (9,10): Black at (10,10) captures the pair
+    b.doMove({ Pos { 7, 10 }, Player::Black }, rules);
+    b.doMove({ Pos { 8, 10 }, Player::White }, rules);
+    b.doMove({ Pos { 0, 0 }, Player::Black }, rules);
+    b.doMove({ Pos { 9, 10 }, Player::White }, rules);
+    const uint64_t before = b.zobristKey();
+    b.doMove({ Pos { 10, 10 }, Player::Black }, rules);
+    CHECK(b.capturedPairs().black == 1);
+    CHECK(b.at(8, 10) == Cell::Empty && b.at(9, 10) == Cell::Empty);
+    b.undoMove();
+    CHECK(b.zobristKey() == before);
+    CHECK(b.capturedPairs().black == 0);
+    CHECK(b.at(8, 10) == Cell::White && b.at(9, 10) == Cell::White);
+    CHECK(b.at(10, 10) == Cell::Empty);
+    CHECK(b.toPlay() == Player::Black);
+    CHECK(b.stoneCount(Player::White) == 2);
+}
+
 TEST(capture_both_directions_two_pairs)
 {
     TestEngine e {};